@@ -0,0 +1,174 @@
+#pragma once
+
+#include <Arduino.h>
+
+// ==============================================================================
+// Animation
+// Fixed-point easing, a fixed-timestep frame pacer and tile slide geometry.
+// Nothing here draws: main.cpp renders each frame into the Compositor.
+//
+// Time is in microseconds and positions follow the frame tick, not the moment
+// loop() got around to rendering, so a slide advances by the same step every
+// frame. A late frame skips the ticks it missed instead of stretching the
+// animation.
+// ==============================================================================
+
+enum EaseCurve {
+    EASE_LINEAR,
+    EASE_OUT_QUAD,
+    EASE_OUT_CUBIC,         // Fast start, soft landing (tile slides)
+    EASE_IN_OUT_CUBIC
+};
+
+class Easing {
+public:
+    static const int32_t ONE = 1 << 16;     // Q16: 0..ONE
+
+    // t and result in Q16; exact at 0 and ONE
+    static int32_t apply(EaseCurve curve, int32_t t) {
+        if (t <= 0) return 0;
+        if (t >= ONE) return ONE;
+        int64_t u = ONE - t;
+        switch (curve) {
+            case EASE_OUT_QUAD:
+                return (int32_t)(ONE - ((u * u) >> 16));
+            case EASE_OUT_CUBIC:
+                return (int32_t)(ONE - ((u * u * u) >> 32));
+            case EASE_IN_OUT_CUBIC:
+                if (t < ONE / 2) return (int32_t)((4 * (int64_t)t * t * t) >> 32);
+                u = 2 * (int64_t)(ONE - t);                 // -2t + 2
+                return (int32_t)(ONE - ((u * u * u) >> 33));
+            case EASE_LINEAR:
+            default:
+                return t;
+        }
+    }
+};
+
+// ==============================================================================
+// FramePacer: ticks at a target rate and records frame timing
+// ==============================================================================
+class FramePacer {
+public:
+    struct Stats {
+        uint32_t frames;
+        uint32_t skippedTicks;      // Ticks missed because a frame ran late
+        uint32_t minIntervalUs;     // Between consecutive frames
+        uint32_t maxIntervalUs;
+        uint32_t totalIntervalUs;
+        uint32_t maxWorkUs;         // Render + flush of one frame
+        uint32_t totalWorkUs;
+    };
+
+private:
+    uint32_t periodUs;
+    uint32_t startUs = 0;
+    uint32_t tick = 0;              // Next tick to present
+    uint32_t frameUs = 0;           // Start of the current frame
+    uint32_t lastFrameUs = 0;
+    Stats stats = {};
+
+public:
+    explicit FramePacer(int fps) : periodUs(1000000 / fps) {}
+
+    uint32_t getPeriodUs() const { return periodUs; }
+
+    // Tick 0 is what is already on screen: the first frame is due a period later
+    void start(uint32_t nowUs) {
+        startUs = nowUs;
+        tick = 1;
+        stats = {};
+        stats.minIntervalUs = UINT32_MAX;
+    }
+
+    bool due(uint32_t nowUs) const {
+        return nowUs - startUs >= tick * periodUs;
+    }
+
+    uint32_t untilNextUs(uint32_t nowUs) const {
+        uint32_t elapsed = nowUs - startUs;
+        uint32_t next = tick * periodUs;
+        return next > elapsed ? next - elapsed : 0;
+    }
+
+    // Open the frame for the latest tick that is due; returns its animation
+    // time (tick * period) since start()
+    uint32_t beginFrame(uint32_t nowUs) {
+        uint32_t current = (nowUs - startUs) / periodUs;
+        if (current > tick) stats.skippedTicks += current - tick;
+        tick = current;
+
+        if (stats.frames > 0) {
+            uint32_t interval = nowUs - lastFrameUs;
+            if (interval < stats.minIntervalUs) stats.minIntervalUs = interval;
+            if (interval > stats.maxIntervalUs) stats.maxIntervalUs = interval;
+            stats.totalIntervalUs += interval;
+        }
+        lastFrameUs = nowUs;
+        frameUs = nowUs;
+        stats.frames++;
+        return tick++ * periodUs;
+    }
+
+    void endFrame(uint32_t nowUs) {
+        uint32_t work = nowUs - frameUs;
+        if (work > stats.maxWorkUs) stats.maxWorkUs = work;
+        stats.totalWorkUs += work;
+    }
+
+    const Stats& getStats() const { return stats; }
+
+    void printStats(const char* label) const {
+        if (stats.frames < 2) return;
+        uint32_t avg = stats.totalIntervalUs / (stats.frames - 1);
+        Serial.printf("%s: %u frames, %.1f fps (interval %u/%u/%u us min/avg/max), "
+                      "%u skipped ticks, work %u/%u us avg/max\n", label,
+                      (unsigned)stats.frames, avg ? 1000000.0 / avg : 0.0,
+                      (unsigned)stats.minIntervalUs, (unsigned)avg, (unsigned)stats.maxIntervalUs,
+                      (unsigned)stats.skippedTicks,
+                      (unsigned)(stats.totalWorkUs / stats.frames), (unsigned)stats.maxWorkUs);
+    }
+};
+
+// ==============================================================================
+// SlideAnimation: one rectangle (a tile or a run of tiles) moving in a line
+// ==============================================================================
+struct SlideAnimation {
+    int fromX, fromY;
+    int toX, toY;
+    uint32_t durationUs;
+    EaseCurve curve;
+
+    bool isDone(uint32_t timeUs) const { return timeUs >= durationUs; }
+
+    void position(uint32_t timeUs, int& x, int& y) const {
+        int32_t t = timeUs >= durationUs ? Easing::ONE
+                  : (int32_t)(((uint64_t)timeUs << 16) / durationUs);
+        int32_t e = Easing::apply(curve, t);
+        x = fromX + (int)(((int64_t)(toX - fromX) * e) >> 16);
+        y = fromY + (int)(((int64_t)(toY - fromY) * e) >> 16);
+    }
+
+    // Part of the w x h rectangle at (prevX, prevY) left uncovered by moving
+    // it to (x, y). Returns false if nothing was uncovered.
+    static bool uncovered(int prevX, int prevY, int x, int y, int w, int h,
+                          int& sx, int& sy, int& sw, int& sh) {
+        int dx = x - prevX, dy = y - prevY;
+        if (dx == 0 && dy == 0) return false;
+        if (abs(dx) >= w || abs(dy) >= h || (dx != 0 && dy != 0)) {
+            // Jumped clear (or diagonal): the whole old rectangle
+            sx = prevX; sy = prevY; sw = w; sh = h;
+        } else if (dx != 0) {
+            sx = dx > 0 ? prevX : x + w;
+            sy = prevY;
+            sw = abs(dx);
+            sh = h;
+        } else {
+            sx = prevX;
+            sy = dy > 0 ? prevY : y + h;
+            sw = w;
+            sh = abs(dy);
+        }
+        return true;
+    }
+};
@@ -0,0 +1,211 @@
+#pragma once
+
+#include <Arduino.h>
+#include <esp_partition.h>
+#include <string.h>
+#include <vector>
+#include "PuzzleAsset.hpp"
+
+// ==============================================================================
+// AssetBlob
+// Every puzzle's board tiles and win preview, already scaled, in a raw flash
+// partition ("assets", see partitions_blob.csv) that the firmware memory-maps
+// instead of reading. Switching puzzles maps one entry: no file I/O, no
+// decode, no scaling and no PSRAM; TileAtlas::attach() and the win preview
+// point straight into the mapping and the flash cache serves the blits.
+//
+// Built on the host by src/native/tools/build_blob.cpp from the catalog and
+// its .pza assets, and written with esptool. The header carries the CRC-32 of
+// the catalog it was built from; on a mismatch (new puzzles uploaded without
+// a new blob) the firmware ignores it and loads from the filesystem.
+//
+// Layout (little endian):
+//   "PZB1" uint16 version  uint16 count  uint32 catalogCrc  uint32 reserved
+//   count * Entry (20 bytes), in catalog record order
+//   entries, each at a 4 KB (flash sector) boundary:
+//     gridSize^2 tiles of tileSize^2 pixels (TileAtlas layout, border baked in)
+//     previewSize^2 pixels of win preview
+//   Pixels are byte-swapped RGB565, as in the panel buffers.
+// ==============================================================================
+
+class AssetBlob {
+public:
+    static constexpr const char* PARTITION_LABEL = "assets";
+    static const int PARTITION_SUBTYPE = 0x40;
+    static const uint16_t VERSION = 1;
+    static const size_t HEADER_BYTES = 16;
+    static const uint32_t ALIGN = 4096;
+    static const int PREVIEW_SIZE = 200;
+
+    struct Entry {
+        uint32_t offset;            // From the start of the partition
+        uint32_t bytes;             // Tiles + preview
+        uint32_t crc32;             // Of those bytes
+        uint8_t gridSize;
+        uint8_t reserved;
+        uint16_t tileSize;
+        uint16_t previewSize;
+        uint16_t reserved2;
+    };
+    static_assert(sizeof(Entry) == 20, "Entry is read in place from flash");
+
+    // One mapped puzzle (valid until the next map() or unmap())
+    struct View {
+        const uint16_t* tiles;
+        const uint16_t* preview;
+        int gridSize;
+        int tileSize;
+        int previewSize;
+    };
+
+    // Builder input (host)
+    struct Source {
+        int gridSize;
+        int tileSize;
+        int previewSize;
+        std::vector<uint16_t> tiles;
+        std::vector<uint16_t> preview;
+    };
+
+private:
+    const esp_partition_t* partition = nullptr;
+    Entry* entries = nullptr;       // The table, copied to RAM at begin()
+    int count = 0;
+    spi_flash_mmap_handle_t handle = 0;
+    const uint8_t* mapped = nullptr;
+    int mappedIndex = -1;
+
+    static size_t entryBytes(int grid, int tile, int preview) {
+        return ((size_t)grid * grid * tile * tile + (size_t)preview * preview) * sizeof(uint16_t);
+    }
+
+public:
+    ~AssetBlob() { end(); }
+
+    // Find the partition and check it was built from this catalog
+    bool begin(uint32_t catalogCrc, int catalogCount) {
+        end();
+        partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA,
+                                             (esp_partition_subtype_t)PARTITION_SUBTYPE, PARTITION_LABEL);
+        if (!partition) return false;
+
+        uint8_t h[HEADER_BYTES];
+        if (esp_partition_read(partition, 0, h, sizeof(h)) != ESP_OK || memcmp(h, "PZB1", 4) != 0 ||
+            PuzzleAsset::get16(h + 4) != VERSION) {
+            Serial.println("AssetBlob: partition holds no blob");
+            partition = nullptr;
+            return false;
+        }
+        int n = PuzzleAsset::get16(h + 6);
+        uint32_t crc = PuzzleAsset::get32(h + 8);
+        if (n != catalogCount || crc != catalogCrc) {
+            Serial.printf("AssetBlob: built for another catalog (%d puzzles, crc %08x), using files\n",
+                          n, (unsigned)crc);
+            partition = nullptr;
+            return false;
+        }
+
+        entries = (Entry*)malloc(n * sizeof(Entry));
+        if (!entries || esp_partition_read(partition, HEADER_BYTES, entries, n * sizeof(Entry)) != ESP_OK) {
+            end();
+            return false;
+        }
+        for (int i = 0; i < n; i++) {
+            const Entry& e = entries[i];
+            if (e.offset % ALIGN || e.offset > partition->size || e.bytes > partition->size - e.offset ||
+                e.bytes != entryBytes(e.gridSize, e.tileSize, e.previewSize)) {
+                Serial.printf("AssetBlob: bad entry %d\n", i);
+                end();
+                return false;
+            }
+        }
+        count = n;
+        Serial.printf("AssetBlob: %d puzzles in partition '%s' at 0x%06x (%u KB)\n", count,
+                      partition->label, (unsigned)partition->address, (unsigned)(partition->size / 1024));
+        return true;
+    }
+
+    void end() {
+        unmap();
+        free(entries);
+        entries = nullptr;
+        count = 0;
+        partition = nullptr;
+    }
+
+    bool isReady() const { return count > 0; }
+
+    // Map catalog record index; the previous mapping goes away
+    bool map(int index, View& view) {
+        if (index < 0 || index >= count) return false;
+        const Entry& e = entries[index];
+        if (mappedIndex != index) {
+            unmap();
+            const void* ptr = nullptr;
+            unsigned long t0 = micros();
+            if (esp_partition_mmap(partition, e.offset, e.bytes, SPI_FLASH_MMAP_DATA, &ptr, &handle) != ESP_OK) {
+                Serial.printf("AssetBlob: cannot map entry %d\n", index);
+                return false;
+            }
+            mapped = (const uint8_t*)ptr;
+            mappedIndex = index;
+            Serial.printf("AssetBlob: entry %d mapped (%u bytes) in %lu us\n",
+                          index, (unsigned)e.bytes, micros() - t0);
+        }
+        view.tiles = (const uint16_t*)mapped;
+        view.preview = view.tiles + (size_t)e.gridSize * e.gridSize * e.tileSize * e.tileSize;
+        view.gridSize = e.gridSize;
+        view.tileSize = e.tileSize;
+        view.previewSize = e.previewSize;
+        return true;
+    }
+
+    void unmap() {
+        if (mapped) spi_flash_munmap(handle);
+        mapped = nullptr;
+        mappedIndex = -1;
+    }
+
+    // CRC check of one entry through the mapping (reads every byte; tools only)
+    bool verify(int index) {
+        View v;
+        return map(index, v) && PuzzleAsset::crc32(mapped, entries[index].bytes) == entries[index].crc32;
+    }
+
+    // ==========================================================================
+    // Build the partition image (host)
+    // ==========================================================================
+    static std::vector<uint8_t> build(const std::vector<Source>& sources, uint32_t catalogCrc) {
+        if (sources.size() > 0xFFFF) return {};
+        size_t tableEnd = HEADER_BYTES + sources.size() * sizeof(Entry);
+        std::vector<uint8_t> out((tableEnd + ALIGN - 1) / ALIGN * ALIGN, 0xFF);  // Erased flash
+        memcpy(out.data(), "PZB1", 4);
+        PuzzleAsset::put16(&out[4], VERSION);
+        PuzzleAsset::put16(&out[6], (uint16_t)sources.size());
+        PuzzleAsset::put32(&out[8], catalogCrc);
+        PuzzleAsset::put32(&out[12], 0);
+
+        for (size_t i = 0; i < sources.size(); i++) {
+            const Source& s = sources[i];
+            size_t bytes = entryBytes(s.gridSize, s.tileSize, s.previewSize);
+            if (s.tiles.size() * sizeof(uint16_t) + s.preview.size() * sizeof(uint16_t) != bytes) return {};
+
+            uint32_t offset = (uint32_t)out.size();
+            out.resize(offset + (bytes + ALIGN - 1) / ALIGN * ALIGN, 0xFF);
+            memcpy(&out[offset], s.tiles.data(), s.tiles.size() * sizeof(uint16_t));
+            memcpy(&out[offset + s.tiles.size() * sizeof(uint16_t)], s.preview.data(),
+                   s.preview.size() * sizeof(uint16_t));
+
+            uint8_t* rec = &out[HEADER_BYTES + i * sizeof(Entry)];
+            PuzzleAsset::put32(rec, offset);
+            PuzzleAsset::put32(rec + 4, (uint32_t)bytes);
+            PuzzleAsset::put32(rec + 8, PuzzleAsset::crc32(&out[offset], bytes));
+            rec[12] = (uint8_t)s.gridSize;
+            rec[13] = 0;
+            PuzzleAsset::put16(rec + 14, (uint16_t)s.tileSize);
+            PuzzleAsset::put16(rec + 16, (uint16_t)s.previewSize);
+            PuzzleAsset::put16(rec + 18, 0);
+        }
+        return out;
+    }
+};
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <Arduino.h>
+#include "RenderTarget.hpp"
+
+// ==============================================================================
+// Blitter
+// Rectangle writes (images and fills) to a RenderTarget, batched so that a
+// whole redraw is one startWrite/endWrite transaction instead of one per call.
+//
+// A sub-rectangle of a larger image (a tile of the 480x480 puzzle image) goes
+// out as a single strided pushImage: the clip rect is set to the destination
+// and the whole image is pushed at an offset that puts the wanted region under
+// it. The target clips before copying, so only the visible pixels are read, with
+// the image width as the row stride; no per-row pushImage and no copy.
+//
+// Counters: transactions reaching the panel, draw calls and pixels, for the
+// last frame (outermost batch) and in total.
+// ==============================================================================
+
+class Blitter {
+public:
+    struct Counters {
+        uint32_t transactions;      // startWrite/endWrite pairs (unbatched calls: one each)
+        uint32_t calls;             // blit/fill calls
+        uint32_t pixels;
+        uint32_t elapsedUs;         // Frames only: outermost begin() to end()
+    };
+
+    // Scoped batch: Blitter::Frame frame(blitter);
+    class Frame {
+    private:
+        Blitter& blitter;
+    public:
+        explicit Frame(Blitter& b) : blitter(b) { blitter.begin(); }
+        ~Frame() { blitter.end(); }
+        Frame(const Frame&) = delete;
+        Frame& operator=(const Frame&) = delete;
+    };
+
+private:
+    RenderTarget& gfx;
+    int depth = 0;
+    unsigned long frameStart = 0;
+    Counters frame = {};            // Open batch
+    Counters lastFrame = {};
+    Counters total = {};
+    uint32_t frames = 0;
+
+    void account(int w, int h) {
+        Counters& c = depth ? frame : total;
+        if (!depth) c.transactions++;
+        c.calls++;
+        c.pixels += (uint32_t)(w * h);
+    }
+
+public:
+    explicit Blitter(RenderTarget& target) : gfx(target) {}
+
+    // Batches nest; only the outermost pair reaches the panel
+    void begin() {
+        if (depth++ > 0) return;
+        frame = {};
+        frame.transactions = 1;
+        frameStart = micros();
+        gfx.startWrite();
+    }
+
+    void end() {
+        if (depth == 0 || --depth > 0) return;
+        gfx.endWrite();
+        frame.elapsedUs = (uint32_t)(micros() - frameStart);
+        lastFrame = frame;
+        total.transactions += frame.transactions;
+        total.calls += frame.calls;
+        total.pixels += frame.pixels;
+        total.elapsedUs += frame.elapsedUs;
+        frames++;
+    }
+
+    // Contiguous w x h pixels (atlas tiles, line buffers)
+    void blit(int x, int y, int w, int h, const uint16_t* pixels) {
+        gfx.pushImage(x, y, w, h, pixels);
+        account(w, h);
+    }
+
+    // Region (srcX, srcY, w, h) of an imageW x imageH image, drawn at (x, y)
+    void blitRegion(int x, int y, int w, int h,
+                    const uint16_t* image, int imageW, int imageH, int srcX, int srcY) {
+        if (srcX == 0 && w == imageW) {
+            // Whole rows: already contiguous
+            gfx.pushImage(x, y, w, h, image + srcY * imageW);
+        } else {
+            int cx, cy, cw, ch;
+            gfx.getClipRect(cx, cy, cw, ch);
+            gfx.setClipRect(x, y, w, h);
+            gfx.pushImage(x - srcX, y - srcY, imageW, imageH, image);
+            gfx.setClipRect(cx, cy, cw, ch);
+        }
+        account(w, h);
+    }
+
+    void fill(int x, int y, int w, int h, uint16_t color) {
+        gfx.fillRect(x, y, w, h, color);
+        account(w, h);
+    }
+
+    const Counters& getLastFrame() const { return lastFrame; }
+    const Counters& getTotal() const { return total; }
+    uint32_t getFrames() const { return frames; }
+
+    void printLastFrame(const char* label) const {
+        Serial.printf("%s: %u transactions, %u calls, %u px, %u us\n", label,
+                      (unsigned)lastFrame.transactions, (unsigned)lastFrame.calls,
+                      (unsigned)lastFrame.pixels, (unsigned)lastFrame.elapsedUs);
+    }
+};
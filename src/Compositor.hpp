@@ -0,0 +1,192 @@
+#pragma once
+
+#include <Arduino.h>
+#include "RenderTarget.hpp"
+#include "Blitter.hpp"
+
+// ==============================================================================
+// Compositor
+// Full-screen back buffer (any RenderTarget with a pixel buffer: a PSRAM
+// sprite on the device, a plain framebuffer on the host) for the game screen. Draw
+// code paints into gfx() and reports what it touched with damage(); flush()
+// then copies only the damaged rectangles to the panel, once per loop() pass,
+// inside a single Blitter transaction. Intermediate states (a cleared slide
+// path before the tile is drawn over it) never reach the panel.
+//
+// Damage rectangles are merged when their bounding box costs no more pixels
+// than pushing them separately (overlapping or adjacent tiles), and forced
+// together at the cheapest pair when the list is full.
+//
+// Without a back buffer (no PSRAM for it), gfx() is the panel itself and
+// damage/flush do nothing: the game draws directly, as before.
+// ==============================================================================
+
+class Compositor {
+public:
+    static const int MAX_RECTS = 16;
+
+    struct Rect {
+        int16_t x, y, w, h;
+    };
+
+    struct Stats {
+        uint32_t rects;             // Rectangles pushed
+        uint32_t pixelsDamaged;     // Sum of damage() areas, before merging/clipping
+        uint32_t pixelsPushed;      // Pixels copied to the panel
+        uint32_t elapsedUs;
+    };
+
+private:
+    RenderTarget& panel;
+    Blitter& out;
+    RenderTarget* canvas = nullptr;
+    Blitter* canvasBlitter = nullptr;   // Tile blits into the back buffer
+    bool ready = false;
+
+    Rect rects[MAX_RECTS];
+    int rectCount = 0;
+    uint32_t pendingDamage = 0;
+    Stats lastFlush = {};
+    Stats total = {};
+    uint32_t flushes = 0;
+
+    static int32_t area(const Rect& r) { return (int32_t)r.w * r.h; }
+
+    static Rect unite(const Rect& a, const Rect& b) {
+        int x0 = min(a.x, b.x), y0 = min(a.y, b.y);
+        int x1 = max(a.x + a.w, b.x + b.w), y1 = max(a.y + a.h, b.y + b.h);
+        return {(int16_t)x0, (int16_t)y0, (int16_t)(x1 - x0), (int16_t)(y1 - y0)};
+    }
+
+    void removeRect(int i) {
+        rects[i] = rects[--rectCount];
+    }
+
+public:
+    Compositor(RenderTarget& target, Blitter& blitter) : panel(target), out(blitter) {}
+
+    ~Compositor() { release(); }
+
+    // Draw through backBuffer (same size as the panel, with a pixel buffer)
+    bool begin(RenderTarget& backBuffer) {
+        release();
+        if (!backBuffer.buffer() || backBuffer.width() != panel.width() ||
+            backBuffer.height() != panel.height()) {
+            Serial.println("Compositor: no back buffer, drawing direct");
+            return false;
+        }
+        canvas = &backBuffer;
+        canvasBlitter = new Blitter(backBuffer);
+        ready = true;
+        Serial.printf("Compositor: %dx%d back buffer\n", panel.width(), panel.height());
+        return true;
+    }
+
+    void release() {
+        delete canvasBlitter;
+        canvasBlitter = nullptr;
+        canvas = nullptr;
+        ready = false;
+        rectCount = 0;
+    }
+
+    bool isBuffered() const { return ready; }
+
+    // Where game screen drawing goes: the back buffer, or the panel without one
+    RenderTarget& gfx() { return ready ? *canvas : panel; }
+    Blitter& painter() { return ready ? *canvasBlitter : out; }
+
+    void damage(int x, int y, int w, int h) {
+        if (!ready) return;
+        pendingDamage += (uint32_t)(w * h);
+
+        // Clip to the screen
+        int x1 = min(x + w, canvas->width()), y1 = min(y + h, canvas->height());
+        x = max(x, 0);
+        y = max(y, 0);
+        if (x >= x1 || y >= y1) return;
+        Rect r = {(int16_t)x, (int16_t)y, (int16_t)(x1 - x), (int16_t)(y1 - y)};
+
+        // Absorb every rectangle that is no cheaper to push on its own; the
+        // grown rectangle can reach new neighbours, so rescan after a merge
+        for (int i = 0; i < rectCount; ) {
+            Rect u = unite(rects[i], r);
+            if (area(u) <= area(rects[i]) + area(r)) {
+                r = u;
+                removeRect(i);
+                i = 0;
+            } else {
+                i++;
+            }
+        }
+
+        if (rectCount == MAX_RECTS) {
+            // Full: fold into the rectangle that grows least
+            int best = 0;
+            int32_t bestGrowth = INT32_MAX;
+            for (int i = 0; i < rectCount; i++) {
+                int32_t growth = area(unite(rects[i], r)) - area(rects[i]);
+                if (growth < bestGrowth) {
+                    bestGrowth = growth;
+                    best = i;
+                }
+            }
+            r = unite(rects[best], r);
+            removeRect(best);
+        }
+        rects[rectCount++] = r;
+    }
+
+    void damageAll() {
+        damage(0, 0, panel.width(), panel.height());
+    }
+
+    // Drop pending damage (the panel is about to show another screen)
+    void discard() {
+        rectCount = 0;
+        pendingDamage = 0;
+    }
+
+    // Push the damaged rectangles to the panel in one transaction
+    void flush() {
+        if (!ready || rectCount == 0) return;
+        unsigned long t0 = micros();
+
+        Stats s = {};
+        s.pixelsDamaged = pendingDamage;
+        {
+            Blitter::Frame frame(out);
+            for (int i = 0; i < rectCount; i++) {
+                const Rect& r = rects[i];
+                out.blitRegion(r.x, r.y, r.w, r.h, canvas->buffer(), canvas->width(), canvas->height(), r.x, r.y);
+                s.pixelsPushed += (uint32_t)area(r);
+            }
+        }
+        s.rects = (uint32_t)rectCount;
+        s.elapsedUs = (uint32_t)(micros() - t0);
+        rectCount = 0;
+        pendingDamage = 0;
+
+        lastFlush = s;
+        total.rects += s.rects;
+        total.pixelsDamaged += s.pixelsDamaged;
+        total.pixelsPushed += s.pixelsPushed;
+        total.elapsedUs += s.elapsedUs;
+        flushes++;
+    }
+
+    const Stats& getLastFlush() const { return lastFlush; }
+    const Stats& getTotal() const { return total; }
+    uint32_t getFlushes() const { return flushes; }
+
+    // Panel traffic of the last frame: the flush, or the direct draws without a buffer
+    void printLastFrame(const char* label) const {
+        if (!ready) {
+            out.printLastFrame(label);
+            return;
+        }
+        Serial.printf("%s: %u rects, %u px pushed (%u damaged), %u us\n", label,
+                      (unsigned)lastFlush.rects, (unsigned)lastFlush.pixelsPushed,
+                      (unsigned)lastFlush.pixelsDamaged, (unsigned)lastFlush.elapsedUs);
+    }
+};
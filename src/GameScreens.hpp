@@ -0,0 +1,469 @@
+#pragma once
+
+#include <Arduino.h>
+#include <vector>
+#include "RenderTarget.hpp"
+#include "Blitter.hpp"
+#include "PuzzleManager.hpp"
+#include "SlidingPuzzle.hpp"
+#include "TileAtlas.hpp"
+#include "PixelKernels.hpp"
+#include "TileOverlay.hpp"
+#include "Widgets.hpp"
+
+// ==============================================================================
+// GameScreens
+// Every screen of the game, drawn onto a RenderTarget from explicit inputs (no
+// globals), so main.cpp draws them on the panel and src/native/tools/
+// render_screens.cpp draws the same pixels into a host framebuffer. The menu,
+// puzzle select and win screens and the game's button bar are Scenes (see
+// Widgets.hpp): the same widgets draw them and hit-test their touches.
+// ==============================================================================
+
+// UI Constants
+const int SCREEN_SIZE = 480;
+const int STATUS_BAR_HEIGHT = 40;
+const int BUTTON_BAR_HEIGHT = 50;
+const int GAME_AREA_Y = STATUS_BAR_HEIGHT;
+const int GAME_AREA_SIZE = 480 - STATUS_BAR_HEIGHT - BUTTON_BAR_HEIGHT;
+// Grid draws within GAME_AREA_Y to GAME_AREA_Y + GAME_AREA_SIZE
+
+// Status bar text: "Moves: N" left-aligned, "Time: MM:SS" right-aligned
+const int STATUS_TEXT_SIZE = 2;
+const int STATUS_TEXT_MAX = 24;
+const int STATUS_LEFT_X = 10;
+const int STATUS_RIGHT_X = 470;
+
+// Colors
+const uint16_t COL_BG        = 0x1082;  // Dark gray
+const uint16_t COL_MENU_BG   = 0x000F;  // Dark blue
+const uint16_t COL_BTN       = 0x2945;  // Button gray
+const uint16_t COL_BTN_EASY  = 0x07E0;  // Green
+const uint16_t COL_BTN_MED   = 0xFFE0;  // Yellow
+const uint16_t COL_BTN_HARD  = 0xF800;  // Red
+const uint16_t COL_BTN_SEL   = 0x04FF;  // Cyan
+const uint16_t COL_WHITE     = 0xFFFF;
+const uint16_t COL_BLACK     = 0x0000;
+const uint16_t COL_GRID_LINE = 0x4208;  // Grid separator
+const uint16_t COL_EMPTY     = 0x2104;  // Empty tile
+const uint16_t COL_WIN_BG    = 0x0320;  // Dark green
+const uint16_t COL_GOLD      = 0xFEA0;  // Gold
+const uint16_t COL_FLASH_VALID   = 0xFFFF;  // White highlight for valid tile
+const uint16_t COL_FLASH_INVALID = 0xF800;  // Red flash for invalid tile
+const uint16_t COL_FLASH_HINT    = 0xFEA0;  // Gold border for hinted tile
+
+// ==============================================================================
+// Format time as MM:SS
+// ==============================================================================
+inline String formatTime(unsigned long seconds) {
+    int mins = seconds / 60;
+    int secs = seconds % 60;
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%02d:%02d", mins, secs);
+    return String(buf);
+}
+
+// Tile geometry of the board in the game area
+struct BoardLayout {
+    int gridSize;
+    int tileSize;
+    int offsetX;
+    int offsetY;
+
+    static BoardLayout forGrid(int gridSize) {
+        int tileSize = GAME_AREA_SIZE / gridSize;
+        return {gridSize, tileSize, (480 - tileSize * gridSize) / 2,
+                GAME_AREA_Y + (GAME_AREA_SIZE - tileSize * gridSize) / 2};
+    }
+
+    int cellX(int pos) const { return offsetX + (pos % gridSize) * tileSize; }
+    int cellY(int pos) const { return offsetY + (pos / gridSize) * tileSize; }
+};
+
+// What the game screen shows
+struct GameView {
+    const SlidingPuzzle* puzzle;
+    const TileAtlas* atlas;         // Pre-scaled tiles (may be empty)
+    TileOverlay* overlay;           // Feedback masks (may be empty or nullptr)
+    const uint16_t* image;          // 480x480 puzzle image (nullptr with no atlas: numbered tiles)
+    BoardLayout layout;
+    int moves;
+    unsigned long seconds;
+    bool demoActive;
+    uint32_t skipCells;             // Cells left undrawn (the moving block mid-slide)
+};
+
+// What the win screen shows
+struct WinView {
+    const uint16_t* image;
+    int imageSize;                  // Square source size (480, or the blob's preview)
+    int moves;
+    unsigned long seconds;
+    int optimal;                    // -1 if unknown
+    bool demoUsed;
+    int difficulty;
+};
+
+const char* const DIFFICULTY_NAMES[] = {"Easy (3x3)", "Medium (4x4)", "Hard (5x5)"};
+const uint16_t DIFFICULTY_COLORS[] = {COL_BTN_EASY, COL_BTN_MED, COL_BTN_HARD};
+const uint16_t COL_SUBTITLE  = 0xBDF7;  // Light gray
+const uint16_t COL_BTN_BACK  = 0x8000;  // Dark red
+
+// ==============================================================================
+// MAIN MENU
+// ==============================================================================
+class MainMenuScene : public Scene {
+public:
+    Label title;
+    Label title2;
+    Label subtitle;
+    Button easy;
+    Button medium;
+    Button hard;
+
+    MainMenuScene()
+        : Scene({0, 0, SCREEN_SIZE, SCREEN_SIZE}, COL_MENU_BG),
+          title(240, 100, TEXT_MIDDLE_CENTER, 4, COL_WHITE, "SLIDING"),
+          title2(240, 155, TEXT_MIDDLE_CENTER, 4, COL_WHITE, "PUZZLE"),
+          subtitle(240, 220, TEXT_MIDDLE_CENTER, 2, COL_SUBTITLE, "Select Difficulty"),
+          easy({90, 260, 300, 60}, COL_BTN_EASY, "EASY  (3x3)", COL_BLACK, 3),
+          medium({90, 340, 300, 60}, COL_BTN_MED, "MEDIUM (4x4)", COL_BLACK, 3),
+          hard({90, 420, 300, 60}, COL_BTN_HARD, "HARD  (5x5)", COL_WHITE, 3) {
+        add(title);
+        add(title2);
+        add(subtitle);
+        add(easy);
+        add(medium);
+        add(hard);
+    }
+
+    // Difficulty a hit widget selects, or -1
+    int difficultyOf(const Widget* w) const {
+        return w == &easy ? 0 : w == &medium ? 1 : w == &hard ? 2 : -1;
+    }
+
+    Button* button(int difficulty) {
+        return difficulty == 0 ? &easy : difficulty == 1 ? &medium : &hard;
+    }
+};
+
+// ==============================================================================
+// PUZZLE SELECT
+// ==============================================================================
+class PuzzleSelectScene : public Scene {
+public:
+    static const int SLOTS = 5;             // Puzzles per page
+
+    Label title;
+    Label subtitle;
+    Button puzzles[SLOTS];
+    Button back;
+    Button more;                // Next page (wraps); only with more than SLOTS puzzles
+
+    static WidgetRect slot(int i) { return {30, 95 + i * 65, 420, 55}; }
+
+    PuzzleSelectScene()
+        : Scene({0, 0, SCREEN_SIZE, SCREEN_SIZE}, COL_MENU_BG),
+          title(240, 30, TEXT_MIDDLE_CENTER, 3, COL_BTN_EASY, DIFFICULTY_NAMES[0]),
+          subtitle(240, 65, TEXT_MIDDLE_CENTER, 2, COL_SUBTITLE, "Choose a Puzzle"),
+          puzzles{Button(slot(0), COL_BTN, "", COL_WHITE, 2), Button(slot(1), COL_BTN, "", COL_WHITE, 2),
+                  Button(slot(2), COL_BTN, "", COL_WHITE, 2), Button(slot(3), COL_BTN, "", COL_WHITE, 2),
+                  Button(slot(4), COL_BTN, "", COL_WHITE, 2)},
+          back({10, 430, 120, 40}, COL_BTN_BACK, "< Back", COL_WHITE, 2),
+          more({350, 430, 120, 40}, COL_BTN, "More >", COL_WHITE, 2) {
+        add(title);
+        add(subtitle);
+        for (int i = 0; i < SLOTS; i++) add(puzzles[i]);
+        add(back);
+        add(more);
+    }
+
+    // Show one page of a difficulty's puzzles; page wraps around
+    void set(int difficulty, const PuzzleManager& catalog, int page = 0) {
+        int count = catalog.getPuzzleCount(difficulty);
+        int pages = max(1, (count + SLOTS - 1) / SLOTS);
+        shownPage = ((page % pages) + pages) % pages;
+        title.setText(DIFFICULTY_NAMES[difficulty]);
+        title.setColor(DIFFICULTY_COLORS[difficulty]);
+        more.setVisible(pages > 1);
+        if (pages > 1) {
+            char text[48];
+            snprintf(text, sizeof(text), "Choose a Puzzle (%d/%d)", shownPage + 1, pages);
+            subtitle.setText(text);
+        } else {
+            subtitle.setText("Choose a Puzzle");
+        }
+        for (int i = 0; i < SLOTS; i++) {
+            int index = shownPage * SLOTS + i;
+            bool used = index < count;
+            puzzles[i].setVisible(used);
+            if (!used) continue;
+            char label[64];
+            snprintf(label, sizeof(label), "%d. %s", index + 1, catalog.getPuzzle(difficulty, index).displayName);
+            puzzles[i].setCaption(label);
+        }
+    }
+
+    int page() const { return shownPage; }
+
+    // Puzzle index (within the difficulty) of a hit widget, or -1
+    int puzzleOf(const Widget* w) const {
+        for (int i = 0; i < SLOTS; i++) {
+            if (w == &puzzles[i]) return shownPage * SLOTS + i;
+        }
+        return -1;
+    }
+
+    // Button of a puzzle on the shown page
+    Button* button(int index) { return &puzzles[index - shownPage * SLOTS]; }
+
+private:
+    int shownPage = 0;
+};
+
+// ==============================================================================
+// WIN SCREEN
+// ==============================================================================
+class WinScene : public Scene {
+public:
+    ImageView preview;          // Solved image, framed in gold
+    Label title;
+    Label stats;
+    Label compare;              // Optimal length, or "Solved by demo"
+    Label difficulty;
+    Button again;
+    Button menu;
+
+    WinScene()
+        : Scene({0, 0, SCREEN_SIZE, SCREEN_SIZE}, COL_WIN_BG),
+          preview(140, 30, 200, 2, COL_GOLD),
+          title(240, 260, TEXT_MIDDLE_CENTER, 4, COL_GOLD, "YOU WIN!"),
+          stats(240, 300, TEXT_MIDDLE_CENTER, 2, COL_WHITE),
+          compare(240, 330, TEXT_MIDDLE_CENTER, 2, COL_WHITE),
+          difficulty(240, 360, TEXT_MIDDLE_CENTER, 2, COL_SUBTITLE),
+          again({50, 400, 170, 50}, COL_BTN_MED, "Play Again", COL_BLACK, 2),
+          menu({260, 400, 170, 50}, COL_BTN, "Menu", COL_WHITE, 2) {
+        add(preview);
+        add(title);
+        add(stats);
+        add(compare);
+        add(difficulty);
+        add(again);
+        add(menu);
+    }
+
+    void set(const WinView& view) {
+        char buf[64];
+        preview.setImage(view.image, view.imageSize);
+        snprintf(buf, sizeof(buf), "Moves: %d    Time: %s", view.moves, formatTime(view.seconds).c_str());
+        stats.setText(buf);
+
+        // Compare against the scramble's optimal solution, when it is known
+        compare.setVisible(view.demoUsed || view.optimal >= 0);
+        if (view.demoUsed) {
+            compare.setColor(COL_BTN_SEL);
+            compare.setText("Solved by demo");
+        } else if (view.optimal >= 0) {
+            compare.setColor(view.moves <= view.optimal ? COL_GOLD : COL_WHITE);
+            snprintf(buf, sizeof(buf), "Optimal: %d moves (+%d)", view.optimal, view.moves - view.optimal);
+            compare.setText(buf);
+        }
+        difficulty.setText(DIFFICULTY_NAMES[view.difficulty]);
+    }
+};
+
+// ==============================================================================
+// Game screen controls: the button bar (Back / Hint / Solve / Restart), plus
+// the board as a grid for hit-testing. Only the bar is painted here; the
+// board's tiles are drawn by GameScreens::tile().
+// ==============================================================================
+class GameScene : public Scene {
+public:
+    Button back;
+    Button hint;
+    Button solve;               // "Stop" while the demo runs
+    Button restart;
+    GridView board;
+
+    GameScene()
+        : Scene({0, SCREEN_SIZE - BUTTON_BAR_HEIGHT, SCREEN_SIZE, BUTTON_BAR_HEIGHT}, COL_BLACK),
+          back({8, SCREEN_SIZE - BUTTON_BAR_HEIGHT + 5, 110, 40}, COL_BTN_BACK, "< Back", COL_WHITE, 2),
+          hint({126, SCREEN_SIZE - BUTTON_BAR_HEIGHT + 5, 110, 40}, COL_BTN_SEL, "Hint", COL_BLACK, 2),
+          solve({244, SCREEN_SIZE - BUTTON_BAR_HEIGHT + 5, 110, 40}, COL_BTN_EASY, "Solve", COL_BLACK, 2),
+          restart({362, SCREEN_SIZE - BUTTON_BAR_HEIGHT + 5, 110, 40}, COL_BTN_MED, "Restart", COL_BLACK, 2) {
+        add(board);
+        add(back);
+        add(hint);
+        add(solve);
+        add(restart);
+    }
+
+    void setDemoActive(bool active) {
+        solve.setColor(active ? COL_BTN_HARD : COL_BTN_EASY);
+        solve.setCaption(active ? "Stop" : "Solve");
+    }
+
+    void setBoard(const BoardLayout& l) {
+        board.setLayout(l.offsetX, l.offsetY, l.gridSize, l.gridSize, l.tileSize, l.tileSize);
+    }
+};
+
+class GameScreens {
+public:
+    static uint16_t overlayColor(OverlayKind kind) {
+        return kind == OVERLAY_INVALID ? COL_FLASH_INVALID : kind == OVERLAY_HINT ? COL_FLASH_HINT : COL_FLASH_VALID;
+    }
+
+    // ==========================================================================
+    // Flash feedback on tile tileNum at (x, y): the tile's atlas pixels
+    // blended through the kind's mask in one pass and one blit, or drawn
+    // outlines when there is no atlas/mask (numbered tiles, the empty cell)
+    // ==========================================================================
+    static void flash(RenderTarget& gfx, Blitter& painter, const GameView& view, OverlayKind kind,
+                      int tileNum, int x, int y) {
+        int gridSize = view.layout.gridSize;
+        int tileSize = view.layout.tileSize;
+        if (tileNum > 0 && view.atlas && view.atlas->isReady(gridSize, tileSize) &&
+            view.overlay && view.overlay->isReady(tileSize)) {
+            painter.blit(x, y, tileSize, tileSize,
+                         view.overlay->compose(kind, view.atlas->tile(tileNum), overlayColor(kind)));
+            return;
+        }
+        flashOutline(gfx, x, y, tileSize, overlayColor(kind));
+    }
+
+    // Outline-only feedback (no tile pixels to blend with)
+    static void flashOutline(RenderTarget& gfx, int x, int y, int tileSize, uint16_t color) {
+        // Draw a thick border for valid or hinted tile (white/gold)
+        if (color != COL_FLASH_INVALID) {
+            // Draw multiple rectangles for thick border
+            for (int i = 0; i < 3; i++) {
+                gfx.drawRect(x + i, y + i, tileSize - (i * 2), tileSize - (i * 2), color);
+            }
+        } else {
+            // Red border + corners for invalid tile
+            gfx.drawRect(x, y, tileSize, tileSize, color);
+            gfx.drawRect(x + 1, y + 1, tileSize - 2, tileSize - 2, color);
+
+            // Draw diagonal lines in corners for stronger effect
+            for (int i = 0; i < 10; i++) {
+                gfx.drawLine(x + i, y, x, y + i, color);
+                gfx.drawLine(x + tileSize - 1 - i, y, x + tileSize - 1, y + i, color);
+                gfx.drawLine(x + i, y + tileSize - 1, x, y + tileSize - 1 - i, color);
+                gfx.drawLine(x + tileSize - 1 - i, y + tileSize - 1, x + tileSize - 1, y + tileSize - 1 - i, color);
+            }
+        }
+    }
+
+    // ==========================================================================
+    // A single tile at pixel position (x, y)
+    // ==========================================================================
+    static void tile(RenderTarget& gfx, Blitter& painter, const GameView& view, int tileNum, int x, int y) {
+        int gridSize = view.layout.gridSize;
+        int tileSize = view.layout.tileSize;
+
+        if (tileNum == 0) {
+            // Empty tile
+            painter.fill(x, y, tileSize, tileSize, COL_EMPTY);
+            return;
+        }
+
+        // Pre-scaled tile with its border baked in: one blit
+        if (view.atlas && view.atlas->isReady(gridSize, tileSize)) {
+            painter.blit(x, y, tileSize, tileSize, view.atlas->tile(tileNum));
+            return;
+        }
+
+        if (!view.image) {
+            // Fallback: numbered tile
+            gfx.fillRect(x, y, tileSize, tileSize, COL_BTN);
+            gfx.drawRect(x, y, tileSize, tileSize, COL_WHITE);
+            gfx.setTextColor(COL_WHITE);
+            gfx.setTextAlign(TEXT_MIDDLE_CENTER);
+            gfx.setTextSize(2);
+            char buf[4];
+            snprintf(buf, sizeof(buf), "%d", tileNum);
+            gfx.drawString(buf, x + tileSize / 2, y + tileSize / 2);
+            return;
+        }
+
+        // Calculate source region from the original image
+        // Tile N corresponds to position N-1 in the solved puzzle
+        int srcRow = (tileNum - 1) / gridSize;
+        int srcCol = (tileNum - 1) % gridSize;
+
+        // Source coordinates in the 480x480 image
+        // Scale: each tile maps to (480/gridSize) pixels in the source image
+        int imgTileSize = 480 / gridSize;
+        int srcX = srcCol * imgTileSize;
+        int srcY = srcRow * imgTileSize;
+
+        // Draw tile line by line, scaling from image to screen tile size
+        // If tileSize == imgTileSize, it's 1:1. Otherwise we need to scale.
+        if (tileSize == imgTileSize) {
+            // Direct copy: one strided blit out of the full image
+            painter.blitRegion(x, y, tileSize, tileSize, view.image, 480, 480, srcX, srcY);
+        } else {
+            // Scale: use nearest-neighbor (same map for rows and columns)
+            uint16_t* lineBuffer = (uint16_t*)malloc(tileSize * sizeof(uint16_t));
+            if (lineBuffer) {
+                uint16_t map[TileAtlas::IMAGE_SIZE];
+                PixelKernels::buildScaleMap(map, imgTileSize, tileSize);
+                const uint16_t* src = view.image + srcY * 480 + srcX;
+                for (int dy = 0; dy < tileSize; dy++) {
+                    PixelKernels::scaleRow(lineBuffer, src + map[dy] * 480, map, tileSize);
+                    painter.blit(x, y + dy, tileSize, 1, lineBuffer);
+                }
+                free(lineBuffer);
+            }
+        }
+
+        // Draw thin grid border on tile
+        gfx.drawRect(x, y, tileSize, tileSize, COL_GRID_LINE);
+    }
+
+    // ==========================================================================
+    // Status bar (moves, time)
+    // ==========================================================================
+    static void statusBar(RenderTarget& gfx, int moves, unsigned long secs) {
+        gfx.fillRect(0, 0, 480, STATUS_BAR_HEIGHT, COL_BLACK);
+        gfx.setTextColor(COL_WHITE);
+        gfx.setTextAlign(TEXT_MIDDLE_LEFT);
+        gfx.setTextSize(STATUS_TEXT_SIZE);
+
+        char left[STATUS_TEXT_MAX], right[STATUS_TEXT_MAX];
+        statusText(moves, secs, left, right);
+        gfx.drawString(left, STATUS_LEFT_X, STATUS_BAR_HEIGHT / 2);
+
+        gfx.setTextAlign(TEXT_MIDDLE_RIGHT);
+        gfx.drawString(right, STATUS_RIGHT_X, STATUS_BAR_HEIGHT / 2);
+    }
+
+    // Status bar strings (shared with StatusBar's glyph updates)
+    static void statusText(int moves, unsigned long secs, char* left, char* right) {
+        snprintf(left, STATUS_TEXT_MAX, "Moves: %d", moves);
+        snprintf(right, STATUS_TEXT_MAX, "Time: %s", formatTime(secs).c_str());
+    }
+
+    // ==========================================================================
+    // Full game screen
+    // ==========================================================================
+    static void game(RenderTarget& gfx, Blitter& painter, const GameView& view, GameScene& bar) {
+        bar.setDemoActive(view.demoActive);
+        bar.setBoard(view.layout);
+
+        // Clear game area
+        painter.fill(0, GAME_AREA_Y, 480, GAME_AREA_SIZE, COL_BG);
+
+        // Draw all tiles
+        const BoardLayout& l = view.layout;
+        int totalTiles = l.gridSize * l.gridSize;
+        for (int pos = 0; pos < totalTiles; pos++) {
+            if (view.skipCells & (1u << pos)) continue;
+            tile(gfx, painter, view, view.puzzle->getTile(pos), l.cellX(pos), l.cellY(pos));
+        }
+
+        statusBar(gfx, view.moves, view.seconds);
+        bar.drawAll(gfx, painter);
+    }
+};
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <Arduino.h>
+#include "SlidingPuzzle.hpp"
+#include "PuzzleSolver.hpp"
+#include "ReductionSolver.hpp"
+#include "HintTable3x3.hpp"
+#include "PatternDatabase4x4.hpp"
+
+// ==============================================================================
+// HintEngine
+// One solver per grid size, dispatched from the runtime SlidingPuzzle.
+// 3x3 answers come from the precomputed HintTable3x3 and 4x4 searches use
+// the pattern databases, when those are attached. 5x5 hints, and 4x4 hints
+// the budgeted search cannot prove, follow a ReductionSolver plan instead.
+// ==============================================================================
+class HintEngine {
+private:
+    PuzzleSolver<3> solver3;
+    PuzzleSolver<4> solver4;
+    PuzzleSolver<5> solver5;
+    ReductionSolver<4> reducer4;
+    ReductionSolver<5> reducer5;
+    const HintTable3x3* table3 = nullptr;
+
+    template <int N>
+    SolveResult reductionHint(ReductionSolver<N>& reducer, const PuzzleBoard<N>& board) {
+        MoveDir plan[ReductionSolver<N>::MAX_PATH];
+        int len = reducer.solve(board, plan, ReductionSolver<N>::MAX_PATH);
+        const typename ReductionSolver<N>::Stats& s = reducer.getStats();
+
+        SolveResult res = {};
+        res.solved = false;             // Near-optimal plan, not a proof
+        res.bestMove = len > 0 ? plan[0] : MOVE_NONE;
+        res.hintTilePos = len > 0 ? PuzzleBoard<N>::neighbor(board.emptyPos(), plan[0]) : -1;
+        res.solutionLength = -1;
+        res.lowerBound = PuzzleSolver<N>::heuristic(board);
+        res.nodesExpanded = s.statesExpanded;
+        res.elapsedUs = s.elapsedUs;
+        res.nodesPerSecond = s.elapsedUs ? (uint32_t)((uint64_t)s.statesExpanded * 1000000ULL / s.elapsedUs) : 0;
+        return res;
+    }
+
+    // Best available hint per grid size (optimal when the budget allows)
+    SolveResult hint(const PuzzleBoard<3>& board, const SolveBudget& budget) {
+        return solve(board, budget);
+    }
+
+    SolveResult hint(const PuzzleBoard<4>& board, const SolveBudget& budget) {
+        SolveResult res = solve(board, budget);
+        return res.solved ? res : reductionHint(reducer4, board);
+    }
+
+    SolveResult hint(const PuzzleBoard<5>& board, const SolveBudget&) {
+        return reductionHint(reducer5, board);
+    }
+
+    int plan(const PuzzleBoard<3>& board, MoveDir* path, int cap) {
+        if (table3 && table3->isLoaded()) return table3->solution(board, path, cap);
+        SolveBudget unlimited = {0, 0};
+        return solver3.solve(board, unlimited, path, cap).solutionLength;
+    }
+
+    int plan(const PuzzleBoard<4>& board, MoveDir* path, int cap) {
+        return reducer4.solve(board, path, cap);
+    }
+
+    int plan(const PuzzleBoard<5>& board, MoveDir* path, int cap) {
+        return reducer5.solve(board, path, cap);
+    }
+
+public:
+    static const int MAX_PLAN = ReductionSolver<5>::MAX_PATH;
+
+    PuzzleSolver<3>& solverFor(const PuzzleBoard<3>&) { return solver3; }
+    PuzzleSolver<4>& solverFor(const PuzzleBoard<4>&) { return solver4; }
+    PuzzleSolver<5>& solverFor(const PuzzleBoard<5>&) { return solver5; }
+
+    void setTable3(const HintTable3x3* table) {
+        table3 = table;
+        reducer4.setTable3(table);
+        reducer5.setTable3(table);
+    }
+
+    void setPatternDatabase(PatternDatabase4x4* db) { solver4.setPatternDatabase(db); }
+
+    template <int N>
+    SolveResult solve(const PuzzleBoard<N>& board, const SolveBudget& budget) {
+        return solverFor(board).solve(board, budget);
+    }
+
+    // Table lookup: optimal and exact, independent of the budget
+    SolveResult solve(const PuzzleBoard<3>& board, const SolveBudget& budget) {
+        if (!table3 || !table3->isLoaded()) return solver3.solve(board, budget);
+
+        unsigned long t0 = micros();
+        SolveResult res = {};
+        res.solved = true;
+        res.bestMove = table3->bestMove(board);
+        res.hintTilePos = (res.bestMove == MOVE_NONE) ? -1
+                        : PuzzleBoard<3>::neighbor(board.emptyPos(), res.bestMove);
+        res.solutionLength = table3->distance(board);
+        res.lowerBound = res.solutionLength;
+        res.elapsedUs = (SolveCount)(micros() - t0);
+        return res;
+    }
+
+    SolveResult findHint(const SlidingPuzzle& puzzle, const SolveBudget& budget) {
+        return puzzle.visit([&](const auto& board) {
+            return hint(board, budget);
+        });
+    }
+
+    // Full solution for the auto-solve demo: optimal on 3x3, a reduction plan
+    // (bounded time) on 4x4 and 5x5. Returns its length, or -1.
+    int planSolution(const SlidingPuzzle& puzzle, MoveDir* path, int cap) {
+        return puzzle.visit([&](const auto& board) {
+            return plan(board, path, cap);
+        });
+    }
+};
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <Arduino.h>
+#include <FS.h>
+#include "PuzzleBoard.hpp"
+#include "PuzzleRank.hpp"
+
+// ==============================================================================
+// HintTable3x3
+// Perfect next-move table for every solvable 3x3 state, generated offline by
+// a BFS from the goal (src/native/tools/gen_hint3.cpp). Two bits per state
+// hold the MoveDir of an optimal first move, indexed by PuzzleRank<3>:
+// 181,440 states -> 45,360 bytes. Hints are O(1); the optimal length is found
+// by following the table to the goal (at most 31 lookups), with no search.
+//
+// File layout (little endian):
+//   "HNT3"  uint32 stateCount  |  stateCount * 2 bits, 4 states per byte
+// ==============================================================================
+
+class HintTable3x3 {
+public:
+    static constexpr const char* DEFAULT_PATH = "/solver/hint3.bin";
+    static constexpr uint32_t STATES = (uint32_t)PuzzleRank<3>::STATES;
+    static constexpr size_t DATA_BYTES = (STATES + 3) / 4;
+    static constexpr size_t HEADER_BYTES = 8;
+    static constexpr int MAX_OPTIMAL = 31;      // Hardest 3x3 states
+
+private:
+    uint8_t* data = nullptr;
+
+public:
+    ~HintTable3x3() { if (data) free(data); }
+
+    bool isLoaded() const { return data != nullptr; }
+
+    bool load(fs::FS& fs, const char* path = DEFAULT_PATH) {
+        File file = fs.open(path, "r");
+        if (!file) {
+            Serial.printf("HintTable3x3: %s not found (hints fall back to IDA*)\n", path);
+            return false;
+        }
+
+        uint8_t header[HEADER_BYTES];
+        uint32_t count = 0;
+        if (file.read(header, HEADER_BYTES) == HEADER_BYTES) {
+            count = header[4] | (header[5] << 8) | (header[6] << 16) | ((uint32_t)header[7] << 24);
+        }
+        if (memcmp(header, "HNT3", 4) != 0 || count != STATES ||
+            file.size() != HEADER_BYTES + DATA_BYTES) {
+            Serial.printf("HintTable3x3: %s has a bad header\n", path);
+            file.close();
+            return false;
+        }
+
+        uint8_t* buffer = (uint8_t*)malloc(DATA_BYTES);
+        if (!buffer) {
+            Serial.println("HintTable3x3: out of memory");
+            file.close();
+            return false;
+        }
+        size_t got = file.read(buffer, DATA_BYTES);
+        file.close();
+        if (got != DATA_BYTES) {
+            free(buffer);
+            Serial.printf("HintTable3x3: short read (%u bytes)\n", (unsigned)got);
+            return false;
+        }
+
+        if (data) free(data);
+        data = buffer;
+        Serial.printf("HintTable3x3: %u states loaded (%u bytes)\n",
+                      (unsigned)STATES, (unsigned)DATA_BYTES);
+        return true;
+    }
+
+    // Optimal move for the empty slot (MOVE_NONE if solved or not loaded)
+    MoveDir bestMove(const PuzzleBoard<3>& board) const {
+        if (!data || board.isSolved()) return MOVE_NONE;
+        uint32_t i = (uint32_t)PuzzleRank<3>::index(board);
+        return (MoveDir)((data[i >> 2] >> ((i & 3) * 2)) & 3);
+    }
+
+    // Optimal solution (first pathCap moves copied to path, if given). Returns
+    // its length, or -1 if not loaded (or the table is corrupt).
+    int solution(const PuzzleBoard<3>& start, MoveDir* path, int pathCap) const {
+        if (!data) return -1;
+        PuzzleBoard<3> board = start;
+        for (int moves = 0; moves <= MAX_OPTIMAL; moves++) {
+            if (board.isSolved()) return moves;
+            MoveDir d = bestMove(board);
+            if (!board.canSlide(d)) return -1;
+            if (path && moves < pathCap) path[moves] = d;
+            board.slide(d);
+        }
+        return -1;
+    }
+
+    int distance(const PuzzleBoard<3>& start) const {
+        return solution(start, nullptr, 0);
+    }
+};
@@ -0,0 +1,284 @@
+#pragma once
+
+#include <Arduino.h>
+#include <FS.h>
+#include "PuzzleAsset.hpp"
+#include "PuzzleManager.hpp"
+#include "TileAtlas.hpp"
+
+// ==============================================================================
+// ImageCache
+// Decoded puzzles kept in PSRAM: the 480x480 image plus its tile atlas at the
+// board's tile size, for the last few puzzles used. Play Again, Restart after
+// Back, or picking a recent puzzle again skips flash, decode and scaling. It
+// uses least-recently-used eviction and never evicts the puzzle in play.
+//
+// prefetch() queues puzzles the player is likely to pick next, and step()
+// loads them a slice at a time (one .pza band or one atlas cell per unit)
+// from loop() while the puzzle select screen waits for a touch, so a prefetch
+// never stalls input by more than about one slice. acquire() finishes a
+// prefetch that is still in progress rather than starting over.
+//
+// A load decodes bands top to bottom and scales each atlas cell as soon as
+// all of its source rows are in, so a caller can draw the first row of tiles
+// after a fraction of the file (see startGame()).
+// ==============================================================================
+
+class ImageCache {
+public:
+    static const int SLOTS = 4;             // ~765 KB each (image + atlas)
+    static const int QUEUE = 4;
+    static const int IMAGE_SIZE = 480;
+
+    struct Stats {
+        uint32_t hits;              // acquire() found it decoded
+        uint32_t misses;            // acquire() had to load (or finish a prefetch)
+        uint32_t prefetched;        // Loads completed by step()
+        uint32_t evictions;
+    };
+
+    // One cached puzzle
+    struct Slot {
+        int index = -1;             // Catalog record (-1: empty)
+        bool ready = false;         // Image decoded and atlas built
+        uint16_t* image = nullptr;
+        TileAtlas atlas;
+        uint32_t lastUse = 0;
+    };
+
+    // Called as each atlas cell (tile cell + 1) is scaled during a load
+    typedef void (*CellCallback)(void* context, int cell, const TileAtlas& atlas);
+
+private:
+    // A load in progress (acquire or prefetch): bands are decoded in order and
+    // each atlas cell is scaled as soon as its source rows are all decoded
+    struct Pending {
+        PuzzleInfo info;
+        int tileSize;
+        Slot* slot;
+        int decodedRows;            // Rows of the image decoded so far
+        int cell;                   // Next atlas cell to scale
+        bool verified;              // Catalog CRC checked (after the last band)
+    };
+
+    fs::FS& files;
+    AtlasFilter filter;
+    uint16_t borderColor;
+    Slot slots[SLOTS];
+    Slot* pinned = nullptr;         // The puzzle in play
+    PuzzleInfo queue[QUEUE];
+    int queueTiles[QUEUE];
+    int queued = 0;
+    Pending pending = {};
+    AssetReader reader;
+    uint32_t useClock = 0;
+    Stats stats = {};
+
+    Slot* find(int index) {
+        for (Slot& s : slots) {
+            if (s.index == index) return &s;
+        }
+        return nullptr;
+    }
+
+    // Empty slot, or the least recently used one that is neither pinned nor loading
+    Slot* victim() {
+        Slot* best = nullptr;
+        for (Slot& s : slots) {
+            if (&s == pinned || &s == pending.slot) continue;
+            if (s.index < 0) return &s;
+            if (!best || s.lastUse < best->lastUse) best = &s;
+        }
+        if (best) {
+            Serial.printf("ImageCache: evicting puzzle %d\n", best->index);
+            stats.evictions++;
+            clear(*best);
+        }
+        return best;
+    }
+
+    static void clear(Slot& s) {
+        s.atlas.release();
+        s.index = -1;
+        s.ready = false;
+    }
+
+    // Claim a slot and open the asset; false if it cannot start
+    bool begin(const PuzzleInfo& info, int tileSize) {
+        Slot* s = victim();
+        if (!s) return false;
+        if (!s->image) s->image = (uint16_t*)ps_malloc(IMAGE_SIZE * IMAGE_SIZE * sizeof(uint16_t));
+        if (!s->image) {
+            Serial.println("ImageCache: no PSRAM for an image");
+            return false;
+        }
+        s->index = info.index;
+        pending = {info, tileSize, s, 0, 0, false};
+
+        // Raw .rgb565 has no bands: one read here, then scaling as usual
+        bool ok;
+        if (PuzzleAsset::isAsset(info.filename)) {
+            ok = reader.open(files, info.filename, info.offset) &&
+                 reader.getHeader().width == IMAGE_SIZE && reader.getHeader().height == IMAGE_SIZE;
+        } else {
+            ok = reader.load(files, info.filename, s->image, IMAGE_SIZE, IMAGE_SIZE, info.offset);
+            pending.decodedRows = IMAGE_SIZE;
+        }
+        ok = ok && s->atlas.start(info.gridSize, tileSize, filter, borderColor);
+        if (!ok) fail();
+        return ok;
+    }
+
+    void fail() {
+        Serial.printf("ImageCache: failed to load %s\n", pending.info.filename);
+        drop();
+    }
+
+    void drop() {
+        reader.close();
+        clear(*pending.slot);
+        pending.slot = nullptr;
+    }
+
+    // One unit of the pending load: scale the next cell if its rows are in,
+    // else decode the next band. True when the load has finished (either way).
+    bool advance(CellCallback onCell = nullptr, void* context = nullptr) {
+        Pending& p = pending;
+        int grid = p.info.gridSize;
+        if (p.cell < grid * grid && p.decodedRows >= (p.cell / grid + 1) * (IMAGE_SIZE / grid)) {
+            p.slot->atlas.scaleCell(p.slot->image, p.cell);
+            if (onCell) onCell(context, p.cell, p.slot->atlas);
+            p.cell++;
+            if (p.cell < grid * grid || !p.verified) return false;
+            complete();
+            return true;
+        }
+
+        if (p.decodedRows < IMAGE_SIZE) {
+            int c = reader.getNextChunk();
+            if (!reader.readChunk(p.slot->image)) {
+                fail();
+                return true;
+            }
+            p.decodedRows = reader.chunkFirstRow(c) + reader.chunkRowCount(c);
+            return false;
+        }
+
+        // Everything decoded: the CRC covers the whole asset
+        const AssetReader::Stats& s = reader.getStats();
+        reader.close();
+        if (s.crc32 != p.info.crc32) {
+            Serial.printf("ERROR: %s fails its catalog CRC (%08x, expected %08x)\n",
+                          p.info.filename, (unsigned)s.crc32, (unsigned)p.info.crc32);
+            fail();
+            return true;
+        }
+        Serial.printf("Image: %u bytes, read %u us, decode %u us\n",
+                      (unsigned)s.fileBytes, (unsigned)s.readUs, (unsigned)s.decodeUs);
+        p.verified = true;
+        if (p.cell < grid * grid) return false;
+        complete();
+        return true;
+    }
+
+    void complete() {
+        pending.slot->atlas.finish();
+        pending.slot->ready = true;
+        pending.slot = nullptr;
+    }
+
+public:
+    ImageCache(fs::FS& fs, AtlasFilter atlasFilter, uint16_t border)
+        : files(fs), filter(atlasFilter), borderColor(border) {}
+
+    ~ImageCache() {
+        for (Slot& s : slots) free(s.image);
+    }
+
+    // The decoded puzzle, loading it now on a miss; it stays pinned (never
+    // evicted) until unpin(). nullptr if it cannot be loaded. On a miss,
+    // onCell sees every atlas cell as soon as it is scaled (progressive
+    // drawing), including cells a joined prefetch had already scaled.
+    const Slot* acquire(const PuzzleInfo& info, int tileSize,
+                        CellCallback onCell = nullptr, void* context = nullptr) {
+        unpin();
+        Slot* s = find(info.index);
+        if (s && s->ready && s->atlas.isReady(info.gridSize, tileSize)) {
+            stats.hits++;
+            Serial.printf("ImageCache: hit %s (%u hits, %u misses)\n",
+                          info.filename, (unsigned)stats.hits, (unsigned)stats.misses);
+        } else {
+            stats.misses++;
+            unsigned long t0 = millis();
+            bool joined = pending.slot && pending.info.index == info.index && pending.tileSize == tileSize;
+            if (!joined) {
+                if (pending.slot) drop();       // Prefetch of another puzzle
+                if (s) clear(*s);
+                if (!begin(info, tileSize)) return nullptr;
+            }
+            s = pending.slot;
+            if (onCell) {
+                for (int c = 0; c < pending.cell; c++) onCell(context, c, s->atlas);
+            }
+            while (pending.slot && !advance(onCell, context)) {}
+            if (!s->ready) return nullptr;
+            Serial.printf("ImageCache: miss %s, %s in %lu ms (%u hits, %u misses)\n", info.filename,
+                          joined ? "prefetch finished" : "loaded", millis() - t0,
+                          (unsigned)stats.hits, (unsigned)stats.misses);
+        }
+        s->lastUse = ++useClock;
+        pinned = s;
+        return s;
+    }
+
+    // The puzzle in play is done with (it stays cached)
+    void unpin() { pinned = nullptr; }
+
+    // Queue a background load; no-op if cached, loading or already queued
+    void prefetch(const PuzzleInfo& info, int tileSize) {
+        if (find(info.index) || queued >= QUEUE) return;
+        for (int i = 0; i < queued; i++) {
+            if (queue[i].index == info.index) return;
+        }
+        queue[queued] = info;
+        queueTiles[queued] = tileSize;
+        queued++;
+    }
+
+    // Forget queued prefetches (one in progress is kept; acquire may join it)
+    void cancelPrefetch() { queued = 0; }
+
+    // Background work for up to budgetUs; true while any remains
+    bool step(uint32_t budgetUs) {
+        unsigned long t0 = micros();
+        while (micros() - t0 < budgetUs) {
+            if (!pending.slot) {
+                if (!queued) return false;
+                PuzzleInfo info = queue[0];
+                int tileSize = queueTiles[0];
+                queued--;
+                for (int i = 0; i < queued; i++) {
+                    queue[i] = queue[i + 1];
+                    queueTiles[i] = queueTiles[i + 1];
+                }
+                if (find(info.index) || !begin(info, tileSize)) continue;
+            }
+            Slot* s = pending.slot;
+            if (advance() && s->ready) {
+                stats.prefetched++;
+                s->lastUse = ++useClock;
+                Serial.printf("ImageCache: prefetched %s\n", pending.info.filename);
+            }
+        }
+        return pending.slot || queued;
+    }
+
+    bool contains(int index) const {
+        for (const Slot& s : slots) {
+            if (s.index == index && s.ready) return true;
+        }
+        return false;
+    }
+
+    const Stats& getStats() const { return stats; }
+};
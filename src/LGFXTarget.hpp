@@ -0,0 +1,88 @@
+#pragma once
+
+#include <Arduino.h>
+#include <LovyanGFX.hpp>
+#include "RenderTarget.hpp"
+
+// ==============================================================================
+// LGFXTarget
+// RenderTarget on a LovyanGFX device or sprite (thin forwarding, no state).
+// LGFXSpriteTarget owns a 16-bit sprite in PSRAM and exposes its pixels, so it
+// can serve as the Compositor's back buffer.
+// ==============================================================================
+
+class LGFXTarget : public RenderTarget {
+protected:
+    lgfx::LovyanGFX* gfx;
+    uint16_t* pixels = nullptr;
+
+public:
+    explicit LGFXTarget(lgfx::LovyanGFX* target) : gfx(target) {}
+
+    lgfx::LovyanGFX& device() { return *gfx; }
+
+    int width() const override { return gfx->width(); }
+    int height() const override { return gfx->height(); }
+    uint16_t* buffer() override { return pixels; }
+
+    void startWrite() override { gfx->startWrite(); }
+    void endWrite() override { gfx->endWrite(); }
+
+    void setClipRect(int x, int y, int w, int h) override { gfx->setClipRect(x, y, w, h); }
+    void clearClipRect() override { gfx->clearClipRect(); }
+    void getClipRect(int& x, int& y, int& w, int& h) const override {
+        int32_t cx, cy, cw, ch;
+        gfx->getClipRect(&cx, &cy, &cw, &ch);
+        x = cx; y = cy; w = cw; h = ch;
+    }
+
+    void fillScreen(uint16_t color) override { gfx->fillScreen(color); }
+    void fillRect(int x, int y, int w, int h, uint16_t color) override { gfx->fillRect(x, y, w, h, color); }
+    void drawRect(int x, int y, int w, int h, uint16_t color) override { gfx->drawRect(x, y, w, h, color); }
+    void fillRoundRect(int x, int y, int w, int h, int r, uint16_t color) override {
+        gfx->fillRoundRect(x, y, w, h, r, color);
+    }
+    void drawRoundRect(int x, int y, int w, int h, int r, uint16_t color) override {
+        gfx->drawRoundRect(x, y, w, h, r, color);
+    }
+    void drawLine(int x0, int y0, int x1, int y1, uint16_t color) override { gfx->drawLine(x0, y0, x1, y1, color); }
+    void pushImage(int x, int y, int w, int h, const uint16_t* data) override { gfx->pushImage(x, y, w, h, data); }
+
+    void setTextColor(uint16_t color) override { gfx->setTextColor(color); }
+    void setTextSize(int size) override { gfx->setTextSize(size); }
+    void setTextAlign(TextAlign align) override {
+        switch (align) {
+            case TEXT_TOP_LEFT:      gfx->setTextDatum(textdatum_t::top_left); break;
+            case TEXT_MIDDLE_LEFT:   gfx->setTextDatum(textdatum_t::middle_left); break;
+            case TEXT_MIDDLE_CENTER: gfx->setTextDatum(textdatum_t::middle_center); break;
+            case TEXT_MIDDLE_RIGHT:  gfx->setTextDatum(textdatum_t::middle_right); break;
+        }
+    }
+    void drawString(const char* text, int x, int y) override { gfx->drawString(text, x, y); }
+};
+
+class LGFXSpriteTarget : public LGFXTarget {
+private:
+    LGFX_Sprite sprite;
+
+public:
+    explicit LGFXSpriteTarget(lgfx::LovyanGFX* parent) : LGFXTarget(nullptr), sprite(parent) {
+        gfx = &sprite;
+    }
+
+    ~LGFXSpriteTarget() { release(); }
+
+    bool create(int w, int h) {
+        release();
+        sprite.setPsram(true);
+        sprite.setColorDepth(16);
+        if (!sprite.createSprite(w, h)) return false;
+        pixels = (uint16_t*)sprite.getBuffer();
+        return true;
+    }
+
+    void release() {
+        if (pixels) sprite.deleteSprite();
+        pixels = nullptr;
+    }
+};
@@ -0,0 +1,207 @@
+#pragma once
+
+#include <Arduino.h>
+#include <FS.h>
+#include "PuzzleBoard.hpp"
+#include "PuzzleRank.hpp"
+
+// ==============================================================================
+// PatternDatabase4x4
+// Additive disjoint pattern databases for the 4x4 board (default 5-5-5),
+// generated offline by src/native/tools/gen_pdb4.cpp. For each placement of a
+// pattern's tiles, the table holds the fewest moves *of those tiles* needed to
+// bring them home. Summing the patterns is admissible and much tighter than
+// Manhattan distance, which it contains.
+//
+// Entries are 4 bits: (pattern cost - pattern Manhattan) / 2, saturated at 15,
+// so the solver computes h = manhattan + 2 * sum(extra) and keeps using the
+// board's incremental Manhattan distance.
+//
+// Tables are read into PSRAM (fast path) or streamed from the file through a
+// small block cache when memory is short.
+//
+// File layout (little endian), one file per pattern (/solver/pdb4_<i>.bin):
+//   "PDB4"  uint8 k  uint8 tiles[7]  uint32 entries  |  entries * 4 bits
+// ==============================================================================
+
+enum PdbStorage { PDB_IN_PSRAM, PDB_STREAM_FLASH };
+
+class PatternTable4x4 {
+public:
+    static const int MAX_TILES = 7;
+    static const int HEADER_BYTES = 16;
+
+private:
+    static const int BLOCK_BYTES = 512;
+    static const int CACHE_BLOCKS = 16;     // Direct mapped, streaming mode only
+
+    uint8_t k = 0;
+    uint8_t tiles[MAX_TILES] = {};
+    uint32_t entries = 0;
+
+    uint8_t* data = nullptr;                // Whole table (PDB_IN_PSRAM)
+    File file;                              // Open table (PDB_STREAM_FLASH)
+    uint8_t* cache = nullptr;
+    int32_t cacheTag[CACHE_BLOCKS];
+    uint32_t cacheMisses = 0;
+
+    uint8_t readByte(uint32_t offset) {
+        if (data) return data[offset];
+
+        uint32_t block = offset / BLOCK_BYTES;
+        int slot = (int)(block % CACHE_BLOCKS);
+        uint8_t* line = cache + slot * BLOCK_BYTES;
+        if (cacheTag[slot] != (int32_t)block) {
+            file.seek(HEADER_BYTES + block * BLOCK_BYTES);
+            file.read(line, BLOCK_BYTES);
+            cacheTag[slot] = (int32_t)block;
+            cacheMisses++;
+        }
+        return line[offset % BLOCK_BYTES];
+    }
+
+public:
+    ~PatternTable4x4() { unload(); }
+
+    void unload() {
+        if (data) { free(data); data = nullptr; }
+        if (cache) { free(cache); cache = nullptr; }
+        if (file) file.close();
+        k = 0;
+        entries = 0;
+    }
+
+    bool isLoaded() const { return k != 0; }
+    int tileCount() const { return k; }
+    int tileAt(int i) const { return tiles[i]; }
+    bool isStreaming() const { return data == nullptr && cache != nullptr; }
+    uint32_t getCacheMisses() const { return cacheMisses; }
+    size_t dataBytes() const { return (entries + 1) / 2; }
+
+    bool load(fs::FS& fs, const char* path, PdbStorage storage) {
+        unload();
+        File f = fs.open(path, "r");
+        if (!f) return false;
+
+        uint8_t header[HEADER_BYTES];
+        if (f.read(header, HEADER_BYTES) != HEADER_BYTES || memcmp(header, "PDB4", 4) != 0 ||
+            header[4] == 0 || header[4] > MAX_TILES) {
+            Serial.printf("PatternTable4x4: %s has a bad header\n", path);
+            f.close();
+            return false;
+        }
+        uint32_t count = header[12] | (header[13] << 8) | (header[14] << 16) | ((uint32_t)header[15] << 24);
+        if (count != PuzzleRank<4>::patternSize(header[4]) ||
+            f.size() != HEADER_BYTES + (count + 1) / 2) {
+            Serial.printf("PatternTable4x4: %s has the wrong size\n", path);
+            f.close();
+            return false;
+        }
+
+        k = header[4];
+        memcpy(tiles, header + 5, k);
+        entries = count;
+
+        if (storage == PDB_IN_PSRAM) {
+            data = (uint8_t*)ps_malloc(dataBytes());
+            if (data) {
+                size_t got = f.read(data, dataBytes());
+                f.close();
+                if (got == dataBytes()) return true;
+                Serial.printf("PatternTable4x4: short read on %s\n", path);
+                unload();
+                return false;
+            }
+            Serial.printf("PatternTable4x4: no PSRAM for %s, streaming instead\n", path);
+        }
+
+        cache = (uint8_t*)malloc(CACHE_BLOCKS * BLOCK_BYTES);
+        if (!cache) {
+            f.close();
+            unload();
+            return false;
+        }
+        for (int i = 0; i < CACHE_BLOCKS; i++) cacheTag[i] = -1;
+        file = f;
+        return true;
+    }
+
+    // Extra moves over Manhattan for this pattern, halved (0..15)
+    uint8_t extra(const uint8_t* tilePos) {
+        uint8_t cells[MAX_TILES];
+        for (int i = 0; i < k; i++) cells[i] = tilePos[tiles[i]];
+        uint32_t index = PuzzleRank<4>::patternIndex(cells, k);
+        return (readByte(index >> 1) >> ((index & 1) * 4)) & 0x0F;
+    }
+};
+
+class PatternDatabase4x4 {
+public:
+    static const int MAX_PATTERNS = 4;
+    static constexpr const char* DEFAULT_PREFIX = "/solver/pdb4_";
+
+private:
+    PatternTable4x4 patterns[MAX_PATTERNS];
+    int count = 0;
+    int8_t owner[16];                       // Tile -> pattern (-1 = none)
+
+public:
+    PatternDatabase4x4() {
+        for (int t = 0; t < 16; t++) owner[t] = -1;
+    }
+
+    bool isLoaded() const { return count > 0; }
+    int patternCount() const { return count; }
+    int patternOf(int tile) const { return owner[tile]; }
+    PatternTable4x4& pattern(int i) { return patterns[i]; }
+
+    // Load prefix0.bin, prefix1.bin, ... until one is missing
+    bool load(fs::FS& fs, PdbStorage storage, const char* prefix = DEFAULT_PREFIX) {
+        count = 0;
+        for (int t = 0; t < 16; t++) owner[t] = -1;
+
+        size_t bytes = 0;
+        char path[64];
+        for (int i = 0; i < MAX_PATTERNS; i++) {
+            snprintf(path, sizeof(path), "%s%d.bin", prefix, i);
+            if (!fs.exists(path) || !patterns[count].load(fs, path, storage)) break;
+
+            // Patterns must be disjoint for the sum to stay admissible
+            PatternTable4x4& p = patterns[count];
+            bool disjoint = true;
+            for (int j = 0; j < p.tileCount(); j++) {
+                int t = p.tileAt(j);
+                if (t < 1 || t > 15 || owner[t] >= 0) disjoint = false;
+            }
+            if (!disjoint) {
+                Serial.printf("PatternDatabase4x4: %s overlaps another pattern\n", path);
+                p.unload();
+                break;
+            }
+            for (int j = 0; j < p.tileCount(); j++) owner[p.tileAt(j)] = (int8_t)count;
+            bytes += p.dataBytes();
+            count++;
+        }
+
+        if (count == 0) {
+            Serial.println("PatternDatabase4x4: no tables (4x4 hints use Manhattan + linear conflict)");
+            return false;
+        }
+        Serial.printf("PatternDatabase4x4: %d patterns, %u bytes (%s)\n", count, (unsigned)bytes,
+                      patterns[0].isStreaming() ? "streamed" : "PSRAM");
+        return true;
+    }
+
+    uint8_t extra(int pattern, const uint8_t* tilePos) {
+        return patterns[pattern].extra(tilePos);
+    }
+
+    // Standalone estimate (the solver updates one pattern per move instead)
+    int heuristic(const PuzzleBoard<4>& board) {
+        uint8_t tilePos[16];
+        for (int p = 0; p < 16; p++) tilePos[board.tile(p)] = (uint8_t)p;
+        int sum = 0;
+        for (int i = 0; i < count; i++) sum += extra(i, tilePos);
+        return board.manhattan() + 2 * sum;
+    }
+};
@@ -0,0 +1,361 @@
+#pragma once
+
+#include <Arduino.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+// ==============================================================================
+// PixelKernels
+// Row kernels for the panel's byte-swapped RGB565 (docs/COLOR_FORMAT.md):
+// byte swap, nearest scaling through a precomputed index map, 2:1 box
+// downsample and alpha blending against a color.
+//
+// Three implementations with bit-identical results:
+//   Reference   plain per-channel C; the definition of every kernel
+//   Swar        one pixel per 32-bit word with the channels spread apart
+//               (0x07E0F81F), so one multiply-add blends all three; the
+//               byte swap does two pixels per word. Used on the ESP32-S3.
+//   Simd        SSE2 (x86 hosts) or NEON (ARM hosts), 8 pixels per vector;
+//               Swar elsewhere.
+// The PixelKernels:: entry points use Simd; src/native/tools/check_kernels.cpp
+// compares all three on random data.
+//
+// Alpha is 0..255 and quantized to 0..32 ((alpha + 4) >> 3), enough for 5/6-bit
+// channels and small enough for the Swar multiply to stay in 32 bits.
+// ==============================================================================
+
+class PixelKernels {
+public:
+    static uint16_t swap16(uint16_t v) { return (uint16_t)((v << 8) | (v >> 8)); }
+    static int alpha5(uint8_t alpha) { return (alpha + 4) >> 3; }
+
+    // map[d] = offset + d * src / dst: source index of each of dst outputs
+    // (built once per scale, so the row loops carry no division)
+    static void buildScaleMap(uint16_t* map, int src, int dst, int offset = 0) {
+        for (int d = 0; d < dst; d++) map[d] = (uint16_t)(offset + d * src / dst);
+    }
+
+    // ==========================================================================
+    // Reference: one channel at a time
+    // ==========================================================================
+    struct Reference {
+        static void swapBytes(uint16_t* dst, const uint16_t* src, int n) {
+            for (int i = 0; i < n; i++) dst[i] = swap16(src[i]);
+        }
+
+        static void scaleRow(uint16_t* dst, const uint16_t* src, const uint16_t* map, int n) {
+            for (int i = 0; i < n; i++) dst[i] = src[map[i]];
+        }
+
+        // dst[i] = rounded average of the 2x2 block at column 2i of rows a and b
+        static void downsample2x(uint16_t* dst, const uint16_t* a, const uint16_t* b, int n) {
+            for (int i = 0; i < n; i++) {
+                uint16_t p[4] = {swap16(a[2 * i]), swap16(a[2 * i + 1]), swap16(b[2 * i]), swap16(b[2 * i + 1])};
+                int r = 2, g = 2, bl = 2;
+                for (int k = 0; k < 4; k++) {
+                    r += p[k] >> 11;
+                    g += (p[k] >> 5) & 0x3F;
+                    bl += p[k] & 0x1F;
+                }
+                dst[i] = swap16((uint16_t)(((r >> 2) << 11) | ((g >> 2) << 5) | (bl >> 2)));
+            }
+        }
+
+        static uint16_t blendPixel(uint16_t s, uint16_t color, int a) {
+            s = swap16(s);
+            int inv = 32 - a;
+            int r = ((s >> 11) * inv + (color >> 11) * a + 16) >> 5;
+            int g = (((s >> 5) & 0x3F) * inv + ((color >> 5) & 0x3F) * a + 16) >> 5;
+            int b = ((s & 0x1F) * inv + (color & 0x1F) * a + 16) >> 5;
+            return swap16((uint16_t)((r << 11) | (g << 5) | b));
+        }
+
+        // dst = src blended toward color (plain RGB565) by alpha
+        static void blendColor(uint16_t* dst, const uint16_t* src, uint16_t color, uint8_t alpha, int n) {
+            int a = alpha5(alpha);
+            for (int i = 0; i < n; i++) dst[i] = blendPixel(src[i], color, a);
+        }
+
+        // Per-pixel alpha (an overlay mask)
+        static void blendMask(uint16_t* dst, const uint16_t* src, const uint8_t* alpha, uint16_t color, int n) {
+            for (int i = 0; i < n; i++) dst[i] = blendPixel(src[i], color, alpha5(alpha[i]));
+        }
+    };
+
+    // ==========================================================================
+    // Swar: channels spread across a 32-bit word
+    // ==========================================================================
+    struct Swar {
+        static const uint32_t SPREAD = 0x07E0F81F;      // G at 21..26, R at 11..15, B at 0..4
+        static const uint32_t HALF = 0x02008010;        // 16 in each channel (blend rounding)
+        static const uint32_t TWO = 0x00401002;         // 2 in each channel (average rounding)
+
+        static uint32_t spread(uint16_t swapped) {
+            uint32_t p = swap16(swapped);
+            return (p | (p << 16)) & SPREAD;
+        }
+
+        static uint16_t pack(uint32_t x) {
+            x &= SPREAD;
+            return swap16((uint16_t)(x | (x >> 16)));
+        }
+
+        static void swapBytes(uint16_t* dst, const uint16_t* src, int n) {
+            int i = 0;
+            for (; i + 2 <= n; i += 2) {
+                uint32_t w;
+                memcpy(&w, src + i, 4);
+                w = ((w & 0x00FF00FF) << 8) | ((w >> 8) & 0x00FF00FF);
+                memcpy(dst + i, &w, 4);
+            }
+            for (; i < n; i++) dst[i] = swap16(src[i]);
+        }
+
+        static void scaleRow(uint16_t* dst, const uint16_t* src, const uint16_t* map, int n) {
+            int i = 0;
+            for (; i + 4 <= n; i += 4) {
+                dst[i] = src[map[i]];
+                dst[i + 1] = src[map[i + 1]];
+                dst[i + 2] = src[map[i + 2]];
+                dst[i + 3] = src[map[i + 3]];
+            }
+            for (; i < n; i++) dst[i] = src[map[i]];
+        }
+
+        static void downsample2x(uint16_t* dst, const uint16_t* a, const uint16_t* b, int n) {
+            for (int i = 0; i < n; i++) {
+                uint32_t sum = spread(a[2 * i]) + spread(a[2 * i + 1]) +
+                               spread(b[2 * i]) + spread(b[2 * i + 1]) + TWO;
+                dst[i] = pack(sum >> 2);
+            }
+        }
+
+        static void blendColor(uint16_t* dst, const uint16_t* src, uint16_t color, uint8_t alpha, int n) {
+            uint32_t a = (uint32_t)alpha5(alpha);
+            uint32_t c = (((uint32_t)color | ((uint32_t)color << 16)) & SPREAD) * a + HALF;
+            uint32_t inv = 32 - a;
+            for (int i = 0; i < n; i++) dst[i] = pack((spread(src[i]) * inv + c) >> 5);
+        }
+
+        static void blendMask(uint16_t* dst, const uint16_t* src, const uint8_t* alpha, uint16_t color, int n) {
+            uint32_t c = ((uint32_t)color | ((uint32_t)color << 16)) & SPREAD;
+            for (int i = 0; i < n; i++) {
+                uint32_t a = (uint32_t)alpha5(alpha[i]);
+                dst[i] = pack((spread(src[i]) * (32 - a) + c * a + HALF) >> 5);
+            }
+        }
+    };
+
+#if defined(__SSE2__)
+    // ==========================================================================
+    // Simd: SSE2, 8 pixels per vector (Swar for the tails)
+    // ==========================================================================
+    struct Simd {
+        static const char* name() { return "sse2"; }
+
+        static __m128i swap8(__m128i v) { return _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8)); }
+        static __m128i red(__m128i p) { return _mm_srli_epi16(p, 11); }
+        static __m128i green(__m128i p) { return _mm_and_si128(_mm_srli_epi16(p, 5), _mm_set1_epi16(0x3F)); }
+        static __m128i blue(__m128i p) { return _mm_and_si128(p, _mm_set1_epi16(0x1F)); }
+        static __m128i join(__m128i r, __m128i g, __m128i b) {
+            return swap8(_mm_or_si128(_mm_or_si128(_mm_slli_epi16(r, 11), _mm_slli_epi16(g, 5)), b));
+        }
+        static __m128i load(const uint16_t* p) { return _mm_loadu_si128((const __m128i*)p); }
+        static void store(uint16_t* p, __m128i v) { _mm_storeu_si128((__m128i*)p, v); }
+
+        static void swapBytes(uint16_t* dst, const uint16_t* src, int n) {
+            int i = 0;
+            for (; i + 8 <= n; i += 8) store(dst + i, swap8(load(src + i)));
+            Swar::swapBytes(dst + i, src + i, n - i);
+        }
+
+        static void scaleRow(uint16_t* dst, const uint16_t* src, const uint16_t* map, int n) {
+            Swar::scaleRow(dst, src, map, n);       // A gather: nothing to vectorize in SSE2
+        }
+
+        // Sum adjacent lanes of x (row pair channel sums) into 8 outputs
+        static __m128i pairSum(__m128i lo, __m128i hi) {
+            __m128i ones = _mm_set1_epi16(1);
+            return _mm_packs_epi32(_mm_madd_epi16(lo, ones), _mm_madd_epi16(hi, ones));
+        }
+
+        static void downsample2x(uint16_t* dst, const uint16_t* a, const uint16_t* b, int n) {
+            int i = 0;
+            __m128i two = _mm_set1_epi16(2);
+            for (; i + 8 <= n; i += 8) {
+                __m128i a0 = swap8(load(a + 2 * i)), a1 = swap8(load(a + 2 * i + 8));
+                __m128i b0 = swap8(load(b + 2 * i)), b1 = swap8(load(b + 2 * i + 8));
+                __m128i r = pairSum(_mm_add_epi16(red(a0), red(b0)), _mm_add_epi16(red(a1), red(b1)));
+                __m128i g = pairSum(_mm_add_epi16(green(a0), green(b0)), _mm_add_epi16(green(a1), green(b1)));
+                __m128i bl = pairSum(_mm_add_epi16(blue(a0), blue(b0)), _mm_add_epi16(blue(a1), blue(b1)));
+                r = _mm_srli_epi16(_mm_add_epi16(r, two), 2);
+                g = _mm_srli_epi16(_mm_add_epi16(g, two), 2);
+                bl = _mm_srli_epi16(_mm_add_epi16(bl, two), 2);
+                store(dst + i, join(r, g, bl));
+            }
+            Swar::downsample2x(dst + i, a + 2 * i, b + 2 * i, n - i);
+        }
+
+        static __m128i blend8(__m128i s, __m128i cr, __m128i cg, __m128i cb, __m128i a) {
+            __m128i inv = _mm_sub_epi16(_mm_set1_epi16(32), a);
+            __m128i half = _mm_set1_epi16(16);
+            s = swap8(s);
+            __m128i r = _mm_add_epi16(_mm_mullo_epi16(red(s), inv), _mm_mullo_epi16(cr, a));
+            __m128i g = _mm_add_epi16(_mm_mullo_epi16(green(s), inv), _mm_mullo_epi16(cg, a));
+            __m128i b = _mm_add_epi16(_mm_mullo_epi16(blue(s), inv), _mm_mullo_epi16(cb, a));
+            r = _mm_srli_epi16(_mm_add_epi16(r, half), 5);
+            g = _mm_srli_epi16(_mm_add_epi16(g, half), 5);
+            b = _mm_srli_epi16(_mm_add_epi16(b, half), 5);
+            return join(r, g, b);
+        }
+
+        static void blendColor(uint16_t* dst, const uint16_t* src, uint16_t color, uint8_t alpha, int n) {
+            int i = 0;
+            __m128i c = _mm_set1_epi16((short)color);
+            __m128i cr = red(c), cg = green(c), cb = blue(c);
+            __m128i a = _mm_set1_epi16((short)alpha5(alpha));
+            for (; i + 8 <= n; i += 8) store(dst + i, blend8(load(src + i), cr, cg, cb, a));
+            Swar::blendColor(dst + i, src + i, color, alpha, n - i);
+        }
+
+        static void blendMask(uint16_t* dst, const uint16_t* src, const uint8_t* alpha, uint16_t color, int n) {
+            int i = 0;
+            __m128i c = _mm_set1_epi16((short)color);
+            __m128i cr = red(c), cg = green(c), cb = blue(c);
+            for (; i + 8 <= n; i += 8) {
+                __m128i a = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(alpha + i)), _mm_setzero_si128());
+                a = _mm_srli_epi16(_mm_add_epi16(a, _mm_set1_epi16(4)), 3);
+                store(dst + i, blend8(load(src + i), cr, cg, cb, a));
+            }
+            Swar::blendMask(dst + i, src + i, alpha + i, color, n - i);
+        }
+    };
+#elif defined(__ARM_NEON)
+    // ==========================================================================
+    // Simd: NEON, 8 pixels per vector (Swar for the tails)
+    // ==========================================================================
+    struct Simd {
+        static const char* name() { return "neon"; }
+
+        static uint16x8_t swap8(uint16x8_t v) { return vreinterpretq_u16_u8(vrev16q_u8(vreinterpretq_u8_u16(v))); }
+        static uint16x8_t red(uint16x8_t p) { return vshrq_n_u16(p, 11); }
+        static uint16x8_t green(uint16x8_t p) { return vandq_u16(vshrq_n_u16(p, 5), vdupq_n_u16(0x3F)); }
+        static uint16x8_t blue(uint16x8_t p) { return vandq_u16(p, vdupq_n_u16(0x1F)); }
+        static uint16x8_t join(uint16x8_t r, uint16x8_t g, uint16x8_t b) {
+            return swap8(vorrq_u16(vorrq_u16(vshlq_n_u16(r, 11), vshlq_n_u16(g, 5)), b));
+        }
+
+        static void swapBytes(uint16_t* dst, const uint16_t* src, int n) {
+            int i = 0;
+            for (; i + 8 <= n; i += 8) vst1q_u16(dst + i, swap8(vld1q_u16(src + i)));
+            Swar::swapBytes(dst + i, src + i, n - i);
+        }
+
+        static void scaleRow(uint16_t* dst, const uint16_t* src, const uint16_t* map, int n) {
+            Swar::scaleRow(dst, src, map, n);       // A gather: no NEON equivalent
+        }
+
+        static uint16x8_t pairSum(uint16x8_t lo, uint16x8_t hi) {
+            return vcombine_u16(vpadd_u16(vget_low_u16(lo), vget_high_u16(lo)),
+                                vpadd_u16(vget_low_u16(hi), vget_high_u16(hi)));
+        }
+
+        static void downsample2x(uint16_t* dst, const uint16_t* a, const uint16_t* b, int n) {
+            int i = 0;
+            uint16x8_t two = vdupq_n_u16(2);
+            for (; i + 8 <= n; i += 8) {
+                uint16x8_t a0 = swap8(vld1q_u16(a + 2 * i)), a1 = swap8(vld1q_u16(a + 2 * i + 8));
+                uint16x8_t b0 = swap8(vld1q_u16(b + 2 * i)), b1 = swap8(vld1q_u16(b + 2 * i + 8));
+                uint16x8_t r = pairSum(vaddq_u16(red(a0), red(b0)), vaddq_u16(red(a1), red(b1)));
+                uint16x8_t g = pairSum(vaddq_u16(green(a0), green(b0)), vaddq_u16(green(a1), green(b1)));
+                uint16x8_t bl = pairSum(vaddq_u16(blue(a0), blue(b0)), vaddq_u16(blue(a1), blue(b1)));
+                r = vshrq_n_u16(vaddq_u16(r, two), 2);
+                g = vshrq_n_u16(vaddq_u16(g, two), 2);
+                bl = vshrq_n_u16(vaddq_u16(bl, two), 2);
+                vst1q_u16(dst + i, join(r, g, bl));
+            }
+            Swar::downsample2x(dst + i, a + 2 * i, b + 2 * i, n - i);
+        }
+
+        static uint16x8_t blend8(uint16x8_t s, uint16x8_t cr, uint16x8_t cg, uint16x8_t cb, uint16x8_t a) {
+            uint16x8_t inv = vsubq_u16(vdupq_n_u16(32), a);
+            uint16x8_t half = vdupq_n_u16(16);
+            s = swap8(s);
+            uint16x8_t r = vmlaq_u16(vmulq_u16(red(s), inv), cr, a);
+            uint16x8_t g = vmlaq_u16(vmulq_u16(green(s), inv), cg, a);
+            uint16x8_t b = vmlaq_u16(vmulq_u16(blue(s), inv), cb, a);
+            return join(vshrq_n_u16(vaddq_u16(r, half), 5), vshrq_n_u16(vaddq_u16(g, half), 5),
+                        vshrq_n_u16(vaddq_u16(b, half), 5));
+        }
+
+        static void blendColor(uint16_t* dst, const uint16_t* src, uint16_t color, uint8_t alpha, int n) {
+            int i = 0;
+            uint16x8_t c = vdupq_n_u16(color);
+            uint16x8_t cr = red(c), cg = green(c), cb = blue(c);
+            uint16x8_t a = vdupq_n_u16((uint16_t)alpha5(alpha));
+            for (; i + 8 <= n; i += 8) vst1q_u16(dst + i, blend8(vld1q_u16(src + i), cr, cg, cb, a));
+            Swar::blendColor(dst + i, src + i, color, alpha, n - i);
+        }
+
+        static void blendMask(uint16_t* dst, const uint16_t* src, const uint8_t* alpha, uint16_t color, int n) {
+            int i = 0;
+            uint16x8_t c = vdupq_n_u16(color);
+            uint16x8_t cr = red(c), cg = green(c), cb = blue(c);
+            for (; i + 8 <= n; i += 8) {
+                uint16x8_t a = vshrq_n_u16(vaddq_u16(vmovl_u8(vld1_u8(alpha + i)), vdupq_n_u16(4)), 3);
+                vst1q_u16(dst + i, blend8(vld1q_u16(src + i), cr, cg, cb, a));
+            }
+            Swar::blendMask(dst + i, src + i, alpha + i, color, n - i);
+        }
+    };
+#else
+    // ==========================================================================
+    // Simd: no vector unit the compiler can target (ESP32-S3: Swar)
+    // ==========================================================================
+    struct Simd : Swar {
+        static const char* name() { return "swar"; }
+    };
+#endif
+
+    // ==========================================================================
+    // Entry points
+    // ==========================================================================
+    static const char* backend() { return Simd::name(); }
+
+    static void swapBytes(uint16_t* dst, const uint16_t* src, int n) { Simd::swapBytes(dst, src, n); }
+
+    static void scaleRow(uint16_t* dst, const uint16_t* src, const uint16_t* map, int n) {
+        Simd::scaleRow(dst, src, map, n);
+    }
+
+    static void downsample2x(uint16_t* dst, const uint16_t* a, const uint16_t* b, int n) {
+        Simd::downsample2x(dst, a, b, n);
+    }
+
+    static void blendColor(uint16_t* dst, const uint16_t* src, uint16_t color, uint8_t alpha, int n) {
+        Simd::blendColor(dst, src, color, alpha, n);
+    }
+
+    static void blendMask(uint16_t* dst, const uint16_t* src, const uint8_t* alpha, uint16_t color, int n) {
+        Simd::blendMask(dst, src, alpha, color, n);
+    }
+
+    // Nearest-neighbour scale of a w x h block: dst row y is src row mapY[y]
+    // through mapX; repeated source rows are copied from the previous output
+    static void scaleRect(uint16_t* dst, int dstStride, const uint16_t* src, int srcStride,
+                          const uint16_t* mapX, const uint16_t* mapY, int w, int h) {
+        for (int y = 0; y < h; y++) {
+            uint16_t* out = dst + y * dstStride;
+            if (y > 0 && mapY[y] == mapY[y - 1]) {
+                memcpy(out, out - dstStride, w * sizeof(uint16_t));
+            } else {
+                scaleRow(out, src + mapY[y] * srcStride, mapX, w);
+            }
+        }
+    }
+};
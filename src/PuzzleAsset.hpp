@@ -0,0 +1,392 @@
+#pragma once
+
+#include <Arduino.h>
+#include <FS.h>
+#include <vector>
+#include "PixelKernels.hpp"
+
+// ==============================================================================
+// PuzzleAsset
+// Compressed puzzle image (.pza): the 480x480 image cut into bands of
+// chunkRows rows, each compressed on its own, so a loader decodes band by
+// band straight into the PSRAM image with one small read buffer, and could
+// stop, skip or draw between bands.
+//
+// Codec: a QOI-style byte stream over native RGB565 pixels. Every band starts
+// from a black previous pixel and an empty 64-entry color index:
+//   00iiiiii            INDEX    pixel = index[i]
+//   01rrggbb            DIFF     r/g/b = previous + (-2..1)
+//   10gggggg  rrrrbbbb  LUMA     dg in -32..31; r, b = previous + dg/2 + (-8..7)
+//   11nnnnnn            RUN      previous pixel n+1 times (n < 62)
+//   11111110  lo hi     LITERAL  native RGB565, little endian
+// Channel arithmetic wraps (5/6/5 bits). index[(r*3 + g*5 + b*7) & 63] holds
+// the last pixel with that hash. A band that would not shrink is stored raw.
+//
+// File layout (little endian):
+//   "PZA1" uint16 version  uint16 width  uint16 height  uint16 chunkRows
+//          uint16 chunkCount  uint16 reserved
+//   chunkCount * uint32   bytes of each band (bit 31 set: stored raw)
+//   bands, back to back
+// Pixels decode byte-swapped, like the raw .rgb565 assets.
+// ==============================================================================
+
+class PuzzleAsset {
+public:
+    static const uint16_t VERSION = 1;
+    static const size_t HEADER_BYTES = 16;
+    static const int DEFAULT_CHUNK_ROWS = 16;
+    static const uint32_t RAW_FLAG = 0x80000000u;
+
+    enum {
+        OP_INDEX = 0x00,
+        OP_DIFF = 0x40,
+        OP_LUMA = 0x80,
+        OP_RUN = 0xC0,
+        OP_LITERAL = 0xFE,
+        MAX_RUN = 62
+    };
+
+    struct Header {
+        uint16_t version;
+        uint16_t width;
+        uint16_t height;
+        uint16_t chunkRows;
+        uint16_t chunkCount;
+    };
+
+    static int hash(uint16_t p) {
+        return ((p >> 11) * 3 + ((p >> 5) & 63) * 5 + (p & 31) * 7) & 63;
+    }
+
+    static bool isAsset(const char* path) {
+        size_t n = strlen(path);
+        return n > 4 && strcmp(path + n - 4, ".pza") == 0;
+    }
+
+    // ==========================================================================
+    // Encode (host packer): count pixels, byte-swapped, to out
+    // ==========================================================================
+    static void encodeChunk(const uint16_t* src, int count, std::vector<uint8_t>& out) {
+        uint16_t index[64] = {0};
+        uint16_t prev = 0;
+        int run = 0;
+
+        for (int i = 0; i < count; i++) {
+            uint16_t p = PixelKernels::swap16(src[i]);
+            if (p == prev) {
+                if (++run == MAX_RUN) {
+                    out.push_back((uint8_t)(OP_RUN | (run - 1)));
+                    run = 0;
+                }
+                continue;
+            }
+            if (run) {
+                out.push_back((uint8_t)(OP_RUN | (run - 1)));
+                run = 0;
+            }
+
+            int h = hash(p);
+            if (index[h] == p) {
+                out.push_back((uint8_t)(OP_INDEX | h));
+            } else {
+                index[h] = p;
+                int dr = (((p >> 11) - (prev >> 11) + 16) & 31) - 16;
+                int dg = ((((p >> 5) & 63) - ((prev >> 5) & 63) + 32) & 63) - 32;
+                int db = (((p & 31) - (prev & 31) + 16) & 31) - 16;
+                int lr = ((dr - (dg >> 1) + 16) & 31) - 16;
+                int lb = ((db - (dg >> 1) + 16) & 31) - 16;
+                if (dr >= -2 && dr <= 1 && dg >= -2 && dg <= 1 && db >= -2 && db <= 1) {
+                    out.push_back((uint8_t)(OP_DIFF | (dr + 2) << 4 | (dg + 2) << 2 | (db + 2)));
+                } else if (lr >= -8 && lr <= 7 && lb >= -8 && lb <= 7) {
+                    out.push_back((uint8_t)(OP_LUMA | (dg + 32)));
+                    out.push_back((uint8_t)((lr + 8) << 4 | (lb + 8)));
+                } else {
+                    out.push_back(OP_LITERAL);
+                    out.push_back((uint8_t)(p & 0xFF));
+                    out.push_back((uint8_t)(p >> 8));
+                }
+            }
+            prev = p;
+        }
+        if (run) out.push_back((uint8_t)(OP_RUN | (run - 1)));
+    }
+
+    // Whole image (width x height, byte-swapped) to a .pza file image
+    static std::vector<uint8_t> encode(const uint16_t* pixels, int width, int height,
+                                       int chunkRows = DEFAULT_CHUNK_ROWS) {
+        int chunks = (height + chunkRows - 1) / chunkRows;
+        std::vector<uint8_t> out(HEADER_BYTES + chunks * 4);
+        memcpy(out.data(), "PZA1", 4);
+        const uint16_t fields[6] = {VERSION, (uint16_t)width, (uint16_t)height,
+                                    (uint16_t)chunkRows, (uint16_t)chunks, 0};
+        for (int i = 0; i < 6; i++) put16(&out[4 + i * 2], fields[i]);
+
+        std::vector<uint8_t> band;
+        for (int c = 0; c < chunks; c++) {
+            int rows = min(chunkRows, height - c * chunkRows);
+            const uint16_t* src = pixels + (size_t)c * chunkRows * width;
+            size_t rawBytes = (size_t)rows * width * 2;
+            band.clear();
+            encodeChunk(src, rows * width, band);
+
+            uint32_t entry = (uint32_t)band.size();
+            if (band.size() >= rawBytes) {
+                entry = (uint32_t)rawBytes | RAW_FLAG;
+                band.assign((const uint8_t*)src, (const uint8_t*)src + rawBytes);
+            }
+            put32(&out[HEADER_BYTES + c * 4], entry);
+            out.insert(out.end(), band.begin(), band.end());
+        }
+        return out;
+    }
+
+    // ==========================================================================
+    // Decode one band: exactly count pixels, byte-swapped, to dst. False if
+    // the stream is malformed or does not cover count pixels exactly.
+    // ==========================================================================
+    static bool decodeChunk(const uint8_t* src, size_t len, uint16_t* dst, int count) {
+        uint16_t index[64] = {0};
+        uint16_t prev = 0;
+        const uint8_t* end = src + len;
+        int i = 0;
+
+        while (src < end) {
+            uint8_t op = *src++;
+            if (op >= OP_RUN && op < OP_LITERAL) {
+                int run = (op & 63) + 1;
+                if (i + run > count) return false;
+                uint16_t s = PixelKernels::swap16(prev);
+                for (int k = 0; k < run; k++) dst[i++] = s;
+                continue;
+            }
+            if (i >= count) return false;
+
+            uint16_t p;
+            if (op == OP_LITERAL) {
+                if (end - src < 2) return false;
+                p = (uint16_t)(src[0] | src[1] << 8);
+                src += 2;
+                index[hash(p)] = p;
+            } else if (op == 0xFF) {
+                return false;
+            } else if (op < OP_DIFF) {
+                p = index[op];
+            } else {
+                int dr, dg, db;
+                if (op < OP_LUMA) {
+                    dr = ((op >> 4) & 3) - 2;
+                    dg = ((op >> 2) & 3) - 2;
+                    db = (op & 3) - 2;
+                } else {
+                    if (src >= end) return false;
+                    dg = (op & 63) - 32;
+                    dr = (*src >> 4) - 8 + (dg >> 1);
+                    db = (*src & 15) - 8 + (dg >> 1);
+                    src++;
+                }
+                int r = ((prev >> 11) + dr) & 31;
+                int g = (((prev >> 5) & 63) + dg) & 63;
+                int b = ((prev & 31) + db) & 31;
+                p = (uint16_t)(r << 11 | g << 5 | b);
+                index[hash(p)] = p;
+            }
+            dst[i++] = PixelKernels::swap16(p);
+            prev = p;
+        }
+        return i == count;
+    }
+
+    // ==========================================================================
+    // CRC-32 (IEEE, as zlib): chain calls with the previous result, from 0
+    // ==========================================================================
+    static uint32_t crc32(const uint8_t* data, size_t len, uint32_t crc = 0) {
+        static uint32_t table[256];
+        static bool tableReady = false;
+        if (!tableReady) {
+            for (uint32_t i = 0; i < 256; i++) {
+                uint32_t c = i;
+                for (int k = 0; k < 8; k++) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                table[i] = c;
+            }
+            tableReady = true;
+        }
+        crc = ~crc;
+        for (size_t i = 0; i < len; i++) crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+        return ~crc;
+    }
+
+    static void put16(uint8_t* p, uint16_t v) { p[0] = v & 0xFF; p[1] = v >> 8; }
+    static void put32(uint8_t* p, uint32_t v) { for (int i = 0; i < 4; i++) p[i] = (v >> (8 * i)) & 0xFF; }
+    static uint16_t get16(const uint8_t* p) { return (uint16_t)(p[0] | p[1] << 8); }
+    static uint32_t get32(const uint8_t* p) {
+        return p[0] | p[1] << 8 | p[2] << 16 | (uint32_t)p[3] << 24;
+    }
+};
+
+// ==============================================================================
+// AssetReader
+// Streams a .pza file band by band into an image buffer: header and band
+// table in one read, then one read plus one decode per band through a read
+// buffer of one raw band (15 KB at 16 rows) in internal RAM. The asset may
+// start at an offset within the file. The CRC-32 of the bytes read is kept,
+// so after a full read it can be checked against the catalog's.
+// ==============================================================================
+class AssetReader {
+public:
+    struct Stats {
+        uint32_t fileBytes;
+        uint32_t readUs;            // Flash reads
+        uint32_t decodeUs;
+        uint32_t rawChunks;         // Bands stored uncompressed (1 for a raw file)
+        uint32_t crc32;             // Of every byte read so far
+    };
+
+private:
+    File file;
+    PuzzleAsset::Header header = {};
+    uint32_t* sizes = nullptr;      // chunkCount band table entries
+    uint8_t* readBuffer = nullptr;
+    size_t readBufferSize = 0;
+    int nextChunk = 0;
+    Stats stats = {};
+
+public:
+    ~AssetReader() { close(); }
+
+    void close() {
+        if (file) file.close();
+        free(sizes);
+        free(readBuffer);
+        sizes = nullptr;
+        readBuffer = nullptr;
+        readBufferSize = 0;
+    }
+
+    bool open(fs::FS& fs, const char* path, uint32_t offset = 0) {
+        close();
+        stats = {};
+        nextChunk = 0;
+        unsigned long t0 = micros();
+        file = fs.open(path, "r");
+        if (!file || (offset && !file.seek(offset))) {
+            Serial.printf("AssetReader: cannot open %s\n", path);
+            close();
+            return false;
+        }
+        stats.fileBytes = (uint32_t)file.size() - offset;
+
+        uint8_t h[PuzzleAsset::HEADER_BYTES];
+        if (file.read(h, sizeof(h)) != sizeof(h) || memcmp(h, "PZA1", 4) != 0 ||
+            PuzzleAsset::get16(h + 4) != PuzzleAsset::VERSION) {
+            Serial.printf("AssetReader: %s is not a version %d asset\n", path, PuzzleAsset::VERSION);
+            close();
+            return false;
+        }
+        header.version = PuzzleAsset::get16(h + 4);
+        header.width = PuzzleAsset::get16(h + 6);
+        header.height = PuzzleAsset::get16(h + 8);
+        header.chunkRows = PuzzleAsset::get16(h + 10);
+        header.chunkCount = PuzzleAsset::get16(h + 12);
+        if (!header.width || !header.chunkRows ||
+            header.chunkCount != (header.height + header.chunkRows - 1) / header.chunkRows) {
+            Serial.printf("AssetReader: %s has a bad header\n", path);
+            close();
+            return false;
+        }
+
+        size_t tableBytes = header.chunkCount * 4u;
+        readBufferSize = (size_t)header.chunkRows * header.width * 2;
+        sizes = (uint32_t*)malloc(tableBytes);
+        readBuffer = (uint8_t*)malloc(readBufferSize);
+        if (!sizes || !readBuffer || file.read((uint8_t*)sizes, tableBytes) != tableBytes) {
+            Serial.printf("AssetReader: cannot read the band table of %s\n", path);
+            close();
+            return false;
+        }
+        stats.crc32 = PuzzleAsset::crc32(h, sizeof(h));
+        stats.crc32 = PuzzleAsset::crc32((const uint8_t*)sizes, tableBytes, stats.crc32);
+        for (int c = 0; c < header.chunkCount; c++) sizes[c] = PuzzleAsset::get32((const uint8_t*)&sizes[c]);
+        stats.readUs += (uint32_t)(micros() - t0);
+        return true;
+    }
+
+    const PuzzleAsset::Header& getHeader() const { return header; }
+    int getChunkCount() const { return header.chunkCount; }
+    int getNextChunk() const { return nextChunk; }
+    const Stats& getStats() const { return stats; }
+
+    // Rows [first, first + count) of the image that band c holds
+    int chunkFirstRow(int c) const { return c * header.chunkRows; }
+    int chunkRowCount(int c) const { return min((int)header.chunkRows, header.height - c * header.chunkRows); }
+
+    // Decode the next band into image (width x height); false at the end or
+    // on a read/decode error
+    bool readChunk(uint16_t* image) {
+        if (nextChunk >= header.chunkCount) return false;
+        int c = nextChunk;
+        uint32_t bytes = sizes[c] & ~PuzzleAsset::RAW_FLAG;
+        if (bytes > readBufferSize) {
+            Serial.printf("AssetReader: band %d too large (%u bytes)\n", c, (unsigned)bytes);
+            return false;
+        }
+
+        unsigned long t0 = micros();
+        if (file.read(readBuffer, bytes) != bytes) {
+            Serial.printf("AssetReader: short read in band %d\n", c);
+            return false;
+        }
+        stats.crc32 = PuzzleAsset::crc32(readBuffer, bytes, stats.crc32);
+        unsigned long t1 = micros();
+        stats.readUs += (uint32_t)(t1 - t0);
+
+        uint16_t* dst = image + (size_t)chunkFirstRow(c) * header.width;
+        int pixels = chunkRowCount(c) * header.width;
+        if (sizes[c] & PuzzleAsset::RAW_FLAG) {
+            if (bytes != (uint32_t)pixels * 2) return false;
+            memcpy(dst, readBuffer, bytes);
+            stats.rawChunks++;
+        } else if (!PuzzleAsset::decodeChunk(readBuffer, bytes, dst, pixels)) {
+            Serial.printf("AssetReader: band %d is corrupt\n", c);
+            return false;
+        }
+        stats.decodeUs += (uint32_t)(micros() - t1);
+        nextChunk++;
+        return true;
+    }
+
+    // Every remaining band
+    bool readAll(uint16_t* image) {
+        while (nextChunk < header.chunkCount) {
+            if (!readChunk(image)) return false;
+        }
+        return true;
+    }
+
+    // A whole width x height image from path (at offset): a .pza asset band
+    // by band, or a raw .rgb565 dump in one read
+    bool load(fs::FS& fs, const char* path, uint16_t* image, int width, int height, uint32_t offset = 0) {
+        if (PuzzleAsset::isAsset(path)) {
+            bool ok = open(fs, path, offset) && header.width == width && header.height == height && readAll(image);
+            close();
+            return ok;
+        }
+
+        close();
+        stats = {};
+        size_t bytes = (size_t)width * height * 2;
+        unsigned long t0 = micros();
+        File raw = fs.open(path, "r");
+        if (!raw || (offset && !raw.seek(offset))) {
+            Serial.printf("AssetReader: cannot open %s\n", path);
+            return false;
+        }
+        stats.fileBytes = (uint32_t)raw.size() - offset;
+        bool ok = raw.size() >= offset + bytes && raw.read((uint8_t*)image, bytes) == bytes;
+        raw.close();
+        if (ok) stats.crc32 = PuzzleAsset::crc32((const uint8_t*)image, bytes);
+        stats.readUs = (uint32_t)(micros() - t0);
+        stats.rawChunks = 1;
+        if (!ok) Serial.printf("AssetReader: %s is not a %dx%d image\n", path, width, height);
+        return ok;
+    }
+};
@@ -0,0 +1,294 @@
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include <type_traits>
+
+// ==============================================================================
+// PuzzleBoard<N>
+// Compile-time sized board state with packed storage and constexpr geometry.
+// 3x3 and 4x4 boards live in a single uint64_t (one nibble per cell), 5x5
+// uses one byte per cell. Moves and shuffles never allocate, so solvers can
+// copy and replay boards freely.
+//
+// Manhattan distance, misplaced-tile count and inversion parity are kept up
+// to date by each move (O(1) delta), so win and solvability checks are O(1).
+// ==============================================================================
+
+// Direction the *empty slot* travels (the tile on that side slides into the gap)
+enum MoveDir : uint8_t { MOVE_UP = 0, MOVE_DOWN = 1, MOVE_LEFT = 2, MOVE_RIGHT = 3, MOVE_NONE = 0xFF };
+
+inline MoveDir oppositeDir(MoveDir d) { return (MoveDir)(d ^ 1); }
+
+// ==============================================================================
+// Geometry tables (row/col, neighbours, adjacency masks) built at compile time
+// ==============================================================================
+template <int N>
+struct BoardGeometry {
+    static constexpr int CELLS = N * N;
+
+    struct Tables {
+        uint8_t row[CELLS];
+        uint8_t col[CELLS];
+        int8_t neighbor[CELLS][4];      // Indexed by MoveDir, -1 = off board
+        uint8_t moveDirs[CELLS][4];     // Valid MoveDirs, packed to the front
+        uint8_t moveCount[CELLS];       // Number of valid entries in moveDirs
+        uint32_t adjMask[CELLS];        // Bit p set if cell p is adjacent
+        uint8_t dist[CELLS][CELLS];     // Manhattan distance between two cells
+    };
+
+    static constexpr Tables build() {
+        Tables t{};
+        for (int p = 0; p < CELLS; p++) {
+            int r = p / N;
+            int c = p % N;
+            t.row[p] = (uint8_t)r;
+            t.col[p] = (uint8_t)c;
+            t.neighbor[p][MOVE_UP]    = (int8_t)(r > 0     ? p - N : -1);
+            t.neighbor[p][MOVE_DOWN]  = (int8_t)(r < N - 1 ? p + N : -1);
+            t.neighbor[p][MOVE_LEFT]  = (int8_t)(c > 0     ? p - 1 : -1);
+            t.neighbor[p][MOVE_RIGHT] = (int8_t)(c < N - 1 ? p + 1 : -1);
+            t.moveCount[p] = 0;
+            t.adjMask[p] = 0;
+            for (int d = 0; d < 4; d++) {
+                if (t.neighbor[p][d] < 0) continue;
+                t.moveDirs[p][t.moveCount[p]++] = (uint8_t)d;
+                t.adjMask[p] |= 1u << t.neighbor[p][d];
+            }
+        }
+        for (int a = 0; a < CELLS; a++) {
+            for (int b = 0; b < CELLS; b++) {
+                int dr = a / N - b / N;
+                int dc = a % N - b % N;
+                t.dist[a][b] = (uint8_t)((dr < 0 ? -dr : dr) + (dc < 0 ? -dc : dc));
+            }
+        }
+        return t;
+    }
+
+    static constexpr Tables T = build();
+};
+
+template <int N>
+constexpr typename BoardGeometry<N>::Tables BoardGeometry<N>::T;
+
+// ==============================================================================
+// Tile storage
+// ==============================================================================
+template <int N, bool Packed = (N * N <= 16)>
+struct TileStorage;
+
+// Nibble-packed: cell p occupies bits [4p, 4p+4) of one 64-bit word
+template <int N>
+struct TileStorage<N, true> {
+    uint64_t bits;
+
+    void clear() { bits = 0; }
+    int get(int p) const { return (int)((bits >> (p * 4)) & 0xF); }
+    void set(int p, int v) {
+        bits = (bits & ~(0xFULL << (p * 4))) | ((uint64_t)v << (p * 4));
+    }
+    // Move tile t from p into the empty cell e (cell e holds 0)
+    void slide(int p, int e, int t) {
+        bits ^= ((uint64_t)t << (p * 4)) | ((uint64_t)t << (e * 4));
+    }
+    bool operator==(const TileStorage& o) const { return bits == o.bits; }
+};
+
+// One byte per cell (5x5 tiles need 5 bits)
+template <int N>
+struct TileStorage<N, false> {
+    uint8_t cells[N * N];
+
+    void clear() { memset(cells, 0, sizeof(cells)); }
+    int get(int p) const { return cells[p]; }
+    void set(int p, int v) { cells[p] = (uint8_t)v; }
+    void slide(int p, int e, int t) {
+        cells[e] = (uint8_t)t;
+        cells[p] = 0;
+    }
+    bool operator==(const TileStorage& o) const { return memcmp(cells, o.cells, sizeof(cells)) == 0; }
+};
+
+// ==============================================================================
+// Board
+// ==============================================================================
+template <int N>
+class PuzzleBoard {
+public:
+    static_assert(N >= 2 && N <= 5, "PuzzleBoard supports 2x2 through 5x5");
+
+    static constexpr int SIZE = N;
+    static constexpr int CELLS = N * N;
+    using Geometry = BoardGeometry<N>;
+
+private:
+    TileStorage<N> tiles;
+    uint8_t empty;
+    uint8_t md;             // Sum of tile Manhattan distances to their goal cells
+    uint8_t misplaced;      // Non-empty tiles not on their goal cell
+    uint8_t invParity;      // Inversion count mod 2 (non-empty tiles, reading order)
+
+    // A tile changes cell p -> e: update the tracked statistics
+    void trackMove(int t, int p, int e, MoveDir d) {
+        md = (uint8_t)(md + Geometry::T.dist[t - 1][e] - Geometry::T.dist[t - 1][p]);
+        misplaced = (uint8_t)(misplaced + (p == t - 1) - (e == t - 1));
+        // A vertical move jumps the tile over N-1 others: parity flips for even N
+        if ((N % 2 == 0) && (d == MOVE_UP || d == MOVE_DOWN)) invParity ^= 1;
+    }
+
+    // Full recompute after loading an arbitrary arrangement
+    void recomputeStats() {
+        md = 0;
+        misplaced = 0;
+        for (int p = 0; p < CELLS; p++) {
+            int t = tiles.get(p);
+            if (t == 0) continue;
+            md = (uint8_t)(md + Geometry::T.dist[t - 1][p]);
+            if (p != t - 1) misplaced++;
+        }
+        uint8_t values[CELLS];
+        for (int p = 0; p < CELLS; p++) values[p] = (uint8_t)tiles.get(p);
+        invParity = (uint8_t)inversionParityOf(values);
+    }
+
+public:
+    // Geometry helpers (table lookups, no division)
+    static int row(int p) { return Geometry::T.row[p]; }
+    static int col(int p) { return Geometry::T.col[p]; }
+    static int neighbor(int p, MoveDir d) { return Geometry::T.neighbor[p][d]; }
+    static int distance(int a, int b) { return Geometry::T.dist[a][b]; }
+
+    // Solved state: tiles 1..CELLS-1, then the empty cell
+    void reset() {
+        tiles.clear();
+        for (int p = 0; p < CELLS - 1; p++) tiles.set(p, p + 1);
+        empty = CELLS - 1;
+        md = 0;
+        misplaced = 0;
+        invParity = 0;
+    }
+
+    // Load an arbitrary arrangement (values 0..CELLS-1, 0 = empty)
+    void setTiles(const uint8_t* values) {
+        tiles.clear();
+        for (int p = 0; p < CELLS; p++) {
+            tiles.set(p, values[p]);
+            if (values[p] == 0) empty = (uint8_t)p;
+        }
+        recomputeStats();
+    }
+
+    int tile(int p) const { return tiles.get(p); }
+    int emptyPos() const { return empty; }
+
+    // Tile at tilePos is orthogonally adjacent to the empty cell
+    bool canMove(int tilePos) const {
+        return (unsigned)tilePos < (unsigned)CELLS && ((Geometry::T.adjMask[empty] >> tilePos) & 1);
+    }
+
+    bool canSlide(MoveDir d) const { return Geometry::T.neighbor[empty][d] >= 0; }
+
+    // Move the empty cell one step in direction d (caller checks canSlide)
+    void slide(MoveDir d) {
+        int p = Geometry::T.neighbor[empty][d];
+        int t = tiles.get(p);
+        trackMove(t, p, empty, d);
+        tiles.slide(p, empty, t);
+        empty = (uint8_t)p;
+    }
+
+    // Slide the tile at tilePos into the empty cell, if adjacent
+    bool moveTile(int tilePos) {
+        if (!canMove(tilePos)) return false;
+        slide(dirToward(tilePos));
+        return true;
+    }
+
+    // Number of legal moves from here, and the i-th one
+    int moveCount() const { return Geometry::T.moveCount[empty]; }
+    MoveDir moveAt(int i) const { return (MoveDir)Geometry::T.moveDirs[empty][i]; }
+
+    // Direction the empty cell travels when the tile at tilePos moves
+    MoveDir dirToward(int tilePos) const {
+        int delta = tilePos - empty;
+        if (delta == -N) return MOVE_UP;
+        if (delta == N) return MOVE_DOWN;
+        if (delta == -1 && col(empty) > 0) return MOVE_LEFT;
+        if (delta == 1 && col(tilePos) > 0) return MOVE_RIGHT;
+        return MOVE_NONE;
+    }
+
+    // Tracked statistics (O(1))
+    int manhattan() const { return md; }
+    int misplacedCount() const { return misplaced; }
+    int inversionParity() const { return invParity; }
+    bool isSolved() const { return md == 0; }
+
+    bool operator==(const PuzzleBoard& o) const { return empty == o.empty && tiles == o.tiles; }
+    bool operator!=(const PuzzleBoard& o) const { return !(*this == o); }
+
+    // Inversion parity of the non-empty tiles in reading order, in O(n):
+    // parity of a permutation = (length - number of cycles) mod 2
+    static int inversionParityOf(const uint8_t* values) {
+        uint8_t seq[CELLS];
+        int k = 0;
+        for (int p = 0; p < CELLS; p++) {
+            if (values[p] != 0) seq[k++] = (uint8_t)(values[p] - 1);
+        }
+        uint32_t seen = 0;
+        int cycles = 0;
+        for (int i = 0; i < k; i++) {
+            if (seen & (1u << i)) continue;
+            cycles++;
+            for (int j = i; !(seen & (1u << j)); j = seq[j]) seen |= 1u << j;
+        }
+        return (k - cycles) & 1;
+    }
+
+    // Uniformly random solvable, unsolved arrangement in O(n): Fisher-Yates
+    // over all cells, then one swap of two tiles if the parity is wrong.
+    // Rng needs below(bound) returning [0, bound) (see PuzzleRandom).
+    template <typename Rng>
+    void scramble(Rng& rng) {
+        uint8_t values[CELLS];
+        do {
+            for (int p = 0; p < CELLS; p++) values[p] = (uint8_t)p;
+            for (int i = CELLS - 1; i > 0; i--) {
+                int j = (int)rng.below((uint32_t)(i + 1));
+                uint8_t t = values[i];
+                values[i] = values[j];
+                values[j] = t;
+            }
+            setTiles(values);
+            if (!isSolvable()) {
+                // Swapping two tiles flips inversion parity without moving the gap
+                int a = (values[0] != 0) ? 0 : 1;
+                int b = (values[a + 1] != 0) ? a + 1 : a + 2;
+                uint8_t t = values[a];
+                values[a] = values[b];
+                values[b] = t;
+                setTiles(values);
+            }
+        } while (isSolved());
+    }
+
+    bool isSolvable() const {
+        if (N % 2 == 1) {
+            // Odd grid: solvable if inversions are even
+            return invParity == 0;
+        }
+        // Even grid: solvable if (inversions + empty row from bottom) is odd
+        int emptyRowFromBottom = N - row(empty);
+        return ((invParity + emptyRowFromBottom) % 2 == 1);
+    }
+
+    static PuzzleBoard solved() {
+        PuzzleBoard b;
+        b.reset();
+        return b;
+    }
+};
+
+static_assert(std::is_trivially_copyable<PuzzleBoard<4>>::value, "boards must stay memcpy-able");
+static_assert(sizeof(PuzzleBoard<4>) <= 16, "4x4 board should pack into one word");
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <Arduino.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+// ==============================================================================
+// PuzzleCatalog
+// Binary manifest of the puzzles (/catalog.bin), built on the host by
+// src/native/tools/build_catalog.cpp from tools/puzzles.csv. PuzzleManager
+// reads it with one read into one buffer and uses it in place: entries are
+// fixed-size records and names are offsets into a string pool, so no per-
+// puzzle allocation and nothing else to read at boot.
+//
+// File layout (little endian):
+//   "PZC1" uint16 version  uint16 count  uint32 poolBytes  uint32 reserved
+//   count * Entry (20 bytes), sorted by difficulty, catalog order within one
+//   poolBytes of NUL-terminated strings (paths and display names)
+// ==============================================================================
+
+class PuzzleCatalog {
+public:
+    static constexpr const char* DEFAULT_PATH = "/catalog.bin";
+    static const uint16_t VERSION = 1;
+    static const size_t HEADER_BYTES = 16;
+    static const int DIFFICULTIES = 3;
+
+    struct Entry {
+        uint32_t offset;            // Asset start within its file
+        uint32_t size;              // Asset bytes
+        uint32_t crc32;             // Of those bytes (PuzzleAsset::crc32)
+        uint16_t path;              // Pool offset of the file path
+        uint16_t name;              // Pool offset of the display name
+        uint8_t gridSize;           // 3, 4, or 5
+        uint8_t difficulty;         // 0=Easy, 1=Medium, 2=Hard
+        uint16_t reserved;
+    };
+    static_assert(sizeof(Entry) == 20, "Entry is read in place from the file");
+
+    // Builder input (host)
+    struct Source {
+        std::string path;
+        std::string name;
+        int gridSize;
+        int difficulty;
+        uint32_t offset;
+        uint32_t size;
+        uint32_t crc32;
+    };
+
+    // ==========================================================================
+    // Build the file image; entries are ordered by difficulty (stable). Empty
+    // if the pool would not fit 16-bit offsets.
+    // ==========================================================================
+    static std::vector<uint8_t> build(const std::vector<Source>& sources) {
+        std::vector<uint8_t> pool;
+        std::vector<Entry> entries;
+        for (int d = 0; d < DIFFICULTIES; d++) {
+            for (const Source& s : sources) {
+                if (s.difficulty != d) continue;
+                Entry e = {};
+                e.offset = s.offset;
+                e.size = s.size;
+                e.crc32 = s.crc32;
+                e.path = (uint16_t)pool.size();
+                pool.insert(pool.end(), s.path.begin(), s.path.end());
+                pool.push_back(0);
+                e.name = (uint16_t)pool.size();
+                pool.insert(pool.end(), s.name.begin(), s.name.end());
+                pool.push_back(0);
+                e.gridSize = (uint8_t)s.gridSize;
+                e.difficulty = (uint8_t)d;
+                entries.push_back(e);
+            }
+        }
+        if (pool.size() > 0xFFFF || entries.size() > 0xFFFF) return {};
+
+        std::vector<uint8_t> out(HEADER_BYTES);
+        memcpy(out.data(), "PZC1", 4);
+        put16(&out[4], VERSION);
+        put16(&out[6], (uint16_t)entries.size());
+        put32(&out[8], (uint32_t)pool.size());
+        put32(&out[12], 0);
+        for (const Entry& e : entries) {
+            uint8_t rec[sizeof(Entry)];
+            put32(rec, e.offset);
+            put32(rec + 4, e.size);
+            put32(rec + 8, e.crc32);
+            put16(rec + 12, e.path);
+            put16(rec + 14, e.name);
+            rec[16] = e.gridSize;
+            rec[17] = e.difficulty;
+            put16(rec + 18, 0);
+            out.insert(out.end(), rec, rec + sizeof(rec));
+        }
+        out.insert(out.end(), pool.begin(), pool.end());
+        return out;
+    }
+
+    static void put16(uint8_t* p, uint16_t v) { p[0] = v & 0xFF; p[1] = v >> 8; }
+    static void put32(uint8_t* p, uint32_t v) { for (int i = 0; i < 4; i++) p[i] = (v >> (8 * i)) & 0xFF; }
+};
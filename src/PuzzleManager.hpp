@@ -2,22 +2,52 @@
 
 #include <Arduino.h>
 #include <LittleFS.h>
-#include <vector>
+#include "PuzzleAsset.hpp"
+#include "PuzzleCatalog.hpp"
 
+// One puzzle, as a view into the catalog buffer (valid while it is loaded)
 struct PuzzleInfo {
-    String filename;
-    String displayName;
+    const char* filename;
+    const char* displayName;
     int gridSize;     // 3, 4, or 5
     int difficulty;   // 0=Easy, 1=Medium, 2=Hard
+    uint32_t offset;  // Asset start within the file
+    uint32_t size;    // Asset bytes
+    uint32_t crc32;
+    int index;        // Catalog record (0 .. getTotalCount() - 1)
 };
 
+// ==============================================================================
+// PuzzleManager
+// The puzzle catalog: /catalog.bin (see PuzzleCatalog.hpp) read in a single
+// read into one buffer and used in place, so adding puzzles means rebuilding
+// the catalog and uploading the filesystem, not reflashing. Files are not
+// checked at boot; a missing or damaged asset fails its load (size and CRC).
+// ==============================================================================
 class PuzzleManager {
 private:
-    std::vector<PuzzleInfo> easyPuzzles;
-    std::vector<PuzzleInfo> mediumPuzzles;
-    std::vector<PuzzleInfo> hardPuzzles;
+    uint8_t* catalog = nullptr;     // The whole file
+    const PuzzleCatalog::Entry* entries = nullptr;
+    const char* pool = nullptr;
+    int count = 0;
+    uint32_t catalogCrc = 0;        // Of the whole file (the asset blob records it)
+    int first[PuzzleCatalog::DIFFICULTIES] = {};
+    int counts[PuzzleCatalog::DIFFICULTIES] = {};
+
+    void release() {
+        free(catalog);
+        catalog = nullptr;
+        entries = nullptr;
+        pool = nullptr;
+        count = 0;
+        catalogCrc = 0;
+        memset(first, 0, sizeof(first));
+        memset(counts, 0, sizeof(counts));
+    }
 
 public:
+    ~PuzzleManager() { release(); }
+
     bool init() {
         Serial.println("Initializing PuzzleManager...");
 
@@ -33,106 +63,94 @@ public:
         size_t usedBytes = LittleFS.usedBytes();
         Serial.printf("LittleFS: %d / %d bytes used\n", usedBytes, totalBytes);
 
-        // Easy puzzles (3x3) - RGB565 Format
-        easyPuzzles = {
-            {"/puzzles/easy/castle.rgb565", "Castle Sunset", 3, 0},
-            {"/puzzles/easy/icecream.rgb565", "Ice Cream Park", 3, 0},
-            {"/puzzles/easy/puppy.rgb565", "Puppy Car", 3, 0},
-            {"/puzzles/easy/planet.rgb565", "Space Planet", 3, 0},
-            {"/puzzles/easy/turtle_reef.rgb565", "Turtle Reef", 3, 0}
-        };
-
-        // Medium puzzles (4x4) - RGB565 Format
-        mediumPuzzles = {
-            {"/puzzles/medium/forest.rgb565", "Autumn Path", 4, 1},
-            {"/puzzles/medium/market.rgb565", "Fantasy Market", 4, 1},
-            {"/puzzles/medium/robot.rgb565", "Robot Workshop", 4, 1},
-            {"/puzzles/medium/hangar.rgb565", "Sci-Fi Hangar", 4, 1},
-            {"/puzzles/medium/beach.rgb565", "Beach Paradise", 4, 1}
-        };
-
-        // Hard puzzles (5x5) - RGB565 Format
-        hardPuzzles = {
-            {"/puzzles/hard/nebula.rgb565", "Cosmic Nebula", 5, 2},
-            {"/puzzles/hard/cyberpunk.rgb565", "Cyberpunk City", 5, 2},
-            {"/puzzles/hard/gears.rgb565", "Mechanical Gears", 5, 2},
-            {"/puzzles/hard/androids.rgb565", "Android Pile", 5, 2},
-            {"/puzzles/hard/library.rgb565", "Wizard Library", 5, 2}
-        };
-
-        Serial.println("Puzzle lists initialized:");
-        Serial.printf("  Easy: %d puzzles (3x3)\n", easyPuzzles.size());
-        Serial.printf("  Medium: %d puzzles (4x4)\n", mediumPuzzles.size());
-        Serial.printf("  Hard: %d puzzles (5x5)\n", hardPuzzles.size());
-
-        // Verify files exist
-        Serial.println("\nVerifying puzzle files...");
-        int foundCount = 0;
-        int missingCount = 0;
-
-        for (const auto& puzzle : easyPuzzles) {
-            if (LittleFS.exists(puzzle.filename)) {
-                foundCount++;
-            } else {
-                Serial.printf("  MISSING: %s\n", puzzle.filename.c_str());
-                missingCount++;
-            }
+        if (!load(LittleFS)) {
+            Serial.println("\nWARNING: No puzzle catalog!");
+            Serial.println("Run: pio run --target uploadfs");
+            return false;
         }
 
-        for (const auto& puzzle : mediumPuzzles) {
-            if (LittleFS.exists(puzzle.filename)) {
-                foundCount++;
-            } else {
-                Serial.printf("  MISSING: %s\n", puzzle.filename.c_str());
-                missingCount++;
-            }
-        }
+        Serial.println("Puzzle catalog loaded:");
+        Serial.printf("  Easy: %d puzzles (3x3)\n", counts[0]);
+        Serial.printf("  Medium: %d puzzles (4x4)\n", counts[1]);
+        Serial.printf("  Hard: %d puzzles (5x5)\n", counts[2]);
+        return true;
+    }
 
-        for (const auto& puzzle : hardPuzzles) {
-            if (LittleFS.exists(puzzle.filename)) {
-                foundCount++;
-            } else {
-                Serial.printf("  MISSING: %s\n", puzzle.filename.c_str());
-                missingCount++;
-            }
+    // The catalog file in one read
+    bool load(fs::FS& fs, const char* path = PuzzleCatalog::DEFAULT_PATH) {
+        File file = fs.open(path, "r");
+        if (!file) {
+            Serial.printf("PuzzleManager: %s not found\n", path);
+            return false;
         }
+        size_t size = file.size();
+        uint8_t* buffer = (uint8_t*)malloc(size ? size : 1);
+        bool ok = buffer && file.read(buffer, size) == size;
+        file.close();
+        if (!ok) {
+            Serial.printf("PuzzleManager: cannot read %s\n", path);
+            free(buffer);
+            return false;
+        }
+        return adopt(buffer, size);
+    }
 
-        Serial.printf("Files found: %d / %d\n", foundCount, foundCount + missingCount);
-
-        if (missingCount > 0) {
-            Serial.println("\nWARNING: Some puzzle files are missing!");
-            Serial.println("Run: pio run --target uploadfs");
+    // Use a catalog file image (malloc'd; owned from now on, even on failure)
+    bool adopt(uint8_t* buffer, size_t size) {
+        release();
+        catalog = buffer;
+        if (size < PuzzleCatalog::HEADER_BYTES || memcmp(buffer, "PZC1", 4) != 0 ||
+            (buffer[4] | buffer[5] << 8) != PuzzleCatalog::VERSION) {
+            Serial.println("PuzzleManager: not a catalog (or another version)");
+            release();
+            return false;
+        }
+        int n = buffer[6] | buffer[7] << 8;
+        uint32_t poolBytes = buffer[8] | buffer[9] << 8 | buffer[10] << 16 | (uint32_t)buffer[11] << 24;
+        size_t entryBytes = (size_t)n * sizeof(PuzzleCatalog::Entry);
+        if (size != PuzzleCatalog::HEADER_BYTES + entryBytes + poolBytes ||
+            (poolBytes && buffer[size - 1] != 0)) {
+            Serial.println("PuzzleManager: catalog size mismatch");
+            release();
             return false;
         }
 
-        Serial.println("All puzzle files verified ✓");
+        // Records are little endian, as both targets are: read in place
+        const PuzzleCatalog::Entry* e = (const PuzzleCatalog::Entry*)(buffer + PuzzleCatalog::HEADER_BYTES);
+        for (int i = 0; i < n; i++) {
+            int d = e[i].difficulty;
+            bool sorted = i == 0 || d >= e[i - 1].difficulty;
+            if (d >= PuzzleCatalog::DIFFICULTIES || !sorted || e[i].path >= poolBytes ||
+                e[i].name >= poolBytes || e[i].gridSize < 3 || e[i].gridSize > 5) {
+                Serial.printf("PuzzleManager: bad catalog entry %d\n", i);
+                release();
+                return false;
+            }
+            if (counts[d]++ == 0) first[d] = i;
+        }
+        entries = e;
+        pool = (const char*)(buffer + PuzzleCatalog::HEADER_BYTES + entryBytes);
+        count = n;
+        catalogCrc = PuzzleAsset::crc32(buffer, size);
         return true;
     }
 
-    const std::vector<PuzzleInfo>& getPuzzles(int difficulty) const {
-        switch(difficulty) {
-            case 0: return easyPuzzles;
-            case 1: return mediumPuzzles;
-            case 2: return hardPuzzles;
-            default: return mediumPuzzles;
-        }
-    }
+    int getTotalCount() const { return count; }
+    uint32_t getCatalogCrc() const { return catalogCrc; }
 
     int getPuzzleCount(int difficulty) const {
-        return getPuzzles(difficulty).size();
-    }
-
-    const PuzzleInfo& getPuzzle(int difficulty, int index) const {
-        const auto& puzzles = getPuzzles(difficulty);
-        return puzzles[index % puzzles.size()];
+        return difficulty >= 0 && difficulty < PuzzleCatalog::DIFFICULTIES ? counts[difficulty] : 0;
     }
 
-    bool fileExists(const String& filename) const {
-        return LittleFS.exists(filename);
+    // Puzzle index (wrapping) of a difficulty; the difficulty must have one
+    PuzzleInfo getPuzzle(int difficulty, int index) const {
+        return getRecord(first[difficulty] + index % counts[difficulty]);
     }
 
-    File openPuzzleFile(const String& filename) const {
-        return LittleFS.open(filename, "r");
+    // Catalog record index (difficulty order)
+    PuzzleInfo getRecord(int index) const {
+        const PuzzleCatalog::Entry& e = entries[index];
+        return {pool + e.path, pool + e.name, e.gridSize, e.difficulty, e.offset, e.size, e.crc32, index};
     }
 
     void listFiles() const {
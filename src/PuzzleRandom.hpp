@@ -0,0 +1,57 @@
+#pragma once
+
+#include <stdint.h>
+
+// ==============================================================================
+// PuzzleRandom
+// xoshiro128** (Blackman & Vigna): small, fast and seedable, built on 32-bit
+// operations that suit the ESP32-S3. The same seed gives the same scramble on
+// the device and on the host, unlike Arduino random() (hardware RNG backed).
+// ==============================================================================
+class PuzzleRandom {
+private:
+    uint32_t s[4];
+
+    static uint32_t rotl(uint32_t x, int k) { return (x << k) | (x >> (32 - k)); }
+
+    // splitmix32 expands one seed word into a well-mixed state
+    static uint32_t splitmix(uint32_t& x) {
+        uint32_t z = (x += 0x9E3779B9u);
+        z = (z ^ (z >> 16)) * 0x85EBCA6Bu;
+        z = (z ^ (z >> 13)) * 0xC2B2AE35u;
+        return z ^ (z >> 16);
+    }
+
+public:
+    explicit PuzzleRandom(uint32_t seed = 1) { setSeed(seed); }
+
+    void setSeed(uint32_t seed) {
+        for (int i = 0; i < 4; i++) s[i] = splitmix(seed);
+    }
+
+    uint32_t next() {
+        uint32_t result = rotl(s[1] * 5, 7) * 9;
+        uint32_t t = s[1] << 9;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 11);
+        return result;
+    }
+
+    // Unbiased value in [0, bound) (Lemire's multiply-shift with rejection)
+    uint32_t below(uint32_t bound) {
+        uint64_t m = (uint64_t)next() * bound;
+        uint32_t low = (uint32_t)m;
+        if (low < bound) {
+            uint32_t threshold = (0u - bound) % bound;
+            while (low < threshold) {
+                m = (uint64_t)next() * bound;
+                low = (uint32_t)m;
+            }
+        }
+        return (uint32_t)(m >> 32);
+    }
+};
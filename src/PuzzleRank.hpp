@@ -0,0 +1,119 @@
+#pragma once
+
+#include <stdint.h>
+#include "PuzzleBoard.hpp"
+
+// ==============================================================================
+// PuzzleRank<N>
+// Dense index of the solvable states of PuzzleBoard<N>, for lookup tables.
+//
+//   index = emptyPos * (T! / 2) + lehmer(tiles) / 2      (T = N*N - 1 tiles)
+//
+// lehmer() ranks the tiles in reading order (empty skipped) in the factorial
+// number system. Ranks 2k and 2k+1 differ only by swapping the last two
+// tiles, which flips solvability for a fixed empty position, so halving the
+// rank is a bijection onto the solvable states: 9 * 8!/2 = 181,440 for 3x3.
+// Both directions are O(T) with a bitmask of used values (no sorting).
+// patternIndex() ranks the cells of a tile subset the same way, for the
+// pattern databases (PatternDatabase4x4).
+// ==============================================================================
+
+template <int N>
+class PuzzleRank {
+    static_assert(N >= 3 && N <= 4, "state index must fit in 64 bits");
+
+public:
+    static constexpr int CELLS = N * N;
+    static constexpr int TILES = CELLS - 1;
+
+    static constexpr uint64_t factorial(int n) {
+        return n <= 1 ? 1 : n * factorial(n - 1);
+    }
+
+    static constexpr uint64_t PERMS_PER_EMPTY = factorial(TILES) / 2;
+    static constexpr uint64_t STATES = PERMS_PER_EMPTY * CELLS;
+
+    // Lehmer rank of values (each 0..k-1, all distinct)
+    static uint64_t lehmer(const uint8_t* values, int k) {
+        uint32_t used = 0;
+        uint64_t rank = 0;
+        for (int i = 0; i < k; i++) {
+            uint32_t v = values[i];
+            uint32_t smallerUsed = (uint32_t)__builtin_popcount(used & ((1u << v) - 1));
+            rank = rank * (uint64_t)(k - i) + (v - smallerUsed);
+            used |= 1u << v;
+        }
+        return rank;
+    }
+
+    // Inverse of lehmer(): write the permutation of 0..k-1 with this rank
+    static void unlehmer(uint64_t rank, uint8_t* values, int k) {
+        uint8_t digits[CELLS];
+        for (int i = k - 1; i >= 0; i--) {
+            uint64_t radix = (uint64_t)(k - i);
+            digits[i] = (uint8_t)(rank % radix);
+            rank /= radix;
+        }
+        uint32_t unused = (1u << k) - 1;
+        for (int i = 0; i < k; i++) {
+            // Select the digits[i]-th lowest unused value
+            uint32_t m = unused;
+            for (int s = 0; s < digits[i]; s++) m &= m - 1;
+            uint32_t v = (uint32_t)__builtin_ctz(m);
+            values[i] = (uint8_t)v;
+            unused &= ~(1u << v);
+        }
+    }
+
+    // Entries in a pattern table over k distinct cells: CELLS!/(CELLS-k)!
+    static constexpr uint32_t patternSize(int k) {
+        return k <= 0 ? 1 : (uint32_t)(CELLS - k + 1) * patternSize(k - 1);
+    }
+
+    // Rank of k distinct cells (positions of a tile subset) in [0, patternSize(k))
+    static uint32_t patternIndex(const uint8_t* cells, int k) {
+        uint32_t used = 0;
+        uint32_t rank = 0;
+        for (int i = 0; i < k; i++) {
+            uint32_t c = cells[i];
+            uint32_t smallerUsed = (uint32_t)__builtin_popcount(used & ((1u << c) - 1));
+            rank = rank * (uint32_t)(CELLS - i) + (c - smallerUsed);
+            used |= 1u << c;
+        }
+        return rank;
+    }
+
+    static uint64_t index(const PuzzleBoard<N>& board) {
+        uint8_t values[TILES];
+        int k = 0;
+        for (int p = 0; p < CELLS; p++) {
+            int t = board.tile(p);
+            if (t != 0) values[k++] = (uint8_t)(t - 1);
+        }
+        return (uint64_t)board.emptyPos() * PERMS_PER_EMPTY + lehmer(values, TILES) / 2;
+    }
+
+    static PuzzleBoard<N> board(uint64_t index) {
+        int emptyPos = (int)(index / PERMS_PER_EMPTY);
+        uint8_t values[TILES];
+        unlehmer((index % PERMS_PER_EMPTY) * 2, values, TILES);
+
+        uint8_t tiles[CELLS];
+        PuzzleBoard<N> b;
+        for (int pass = 0; pass < 2; pass++) {
+            for (int p = 0, k = 0; p < CELLS; p++) {
+                tiles[p] = (p == emptyPos) ? 0 : (uint8_t)(values[k++] + 1);
+            }
+            b.setTiles(tiles);
+            if (b.isSolvable()) break;
+            // Ranks 2k and 2k+1 differ by a swap of the last two tiles, so
+            // exactly one of the pair is solvable. Rank parity does not say
+            // which (permutation parity and, on even grids, the empty cell's
+            // row do), so test the even rank and fall back to the odd one.
+            uint8_t t = values[TILES - 1];
+            values[TILES - 1] = values[TILES - 2];
+            values[TILES - 2] = t;
+        }
+        return b;
+    }
+};
@@ -0,0 +1,350 @@
+#pragma once
+
+#include <Arduino.h>
+#include "PuzzleBoard.hpp"
+#include "SlidingPuzzle.hpp"
+#include "PatternDatabase4x4.hpp"
+
+// ==============================================================================
+// PuzzleSolver<N>
+// IDA* over PuzzleBoard<N> with Manhattan distance + linear conflict, and on
+// 4x4 optionally the additive pattern databases (the larger bound is used).
+// The search is budgeted (milliseconds and/or nodes) and anytime: when the
+// budget runs out it still returns the first move toward the best node seen,
+// so a Hint button can answer inside one frame without blocking loop().
+// The search is iterative (no recursion) to keep the loop task stack small.
+// ==============================================================================
+
+// Node and time counters: 32-bit on the device, where a budgeted hint stays
+// far below 2^32 nodes, and 64-bit on the host, where batch_solve runs
+// unbudgeted 5x5 searches that can pass it
+#ifdef ARDUINO
+typedef uint32_t SolveCount;
+#else
+typedef uint64_t SolveCount;
+#endif
+
+struct SolveBudget {
+    uint32_t maxMillis;     // 0 = no time limit
+    SolveCount maxNodes;    // 0 = no node limit
+};
+
+struct SolveResult {
+    bool solved;            // Complete (optimal) solution found within budget
+    MoveDir bestMove;       // First move of the solution, or toward the best node seen
+    int hintTilePos;        // Tile to tap for bestMove (-1 if already solved)
+    int solutionLength;     // Optimal move count if solved, else -1
+    int lowerBound;         // Highest fully searched IDA* bound (optimal >= this)
+    SolveCount nodesExpanded;
+    SolveCount elapsedUs;
+    uint32_t nodesPerSecond;
+};
+
+template <int N>
+class PuzzleSolver {
+public:
+    static constexpr int CELLS = N * N;
+    // Longest path the iterative search can hold (3x3 optimum is <= 31, 4x4 <= 80)
+    static constexpr int MAX_DEPTH = (N == 3) ? 32 : (N == 4) ? 96 : 224;
+
+private:
+    using Board = PuzzleBoard<N>;
+
+    struct Frame {
+        uint8_t nextMove;       // Index into the legal moves at this depth
+        uint8_t savedLcA;       // Line conflicts before the move out of this depth
+        uint8_t savedLcB;
+        uint8_t savedPdb;       // Extra of the moved tile's pattern before the move
+    };
+
+    Board board;                // Tracks its own Manhattan distance incrementally
+    bool useLinearConflict = true;
+    int lcSum;                  // Sum of all line conflicts
+    uint8_t lcRow[N];
+    uint8_t lcCol[N];
+
+    PatternDatabase4x4* pdb = nullptr;      // 4x4 only
+    int pdbSum;                 // Sum of pattern extras (each worth 2 moves)
+    uint8_t pdbExtra[PatternDatabase4x4::MAX_PATTERNS];
+    uint8_t tilePos[CELLS];     // Where each tile is (pattern lookups)
+
+    Frame frames[MAX_DEPTH + 1];
+    MoveDir path[MAX_DEPTH];
+
+    // --------------------------------------------------------------------------
+    // Linear conflict for one line: tiles that belong in this line but sit in
+    // the wrong order. 2 * (tiles in line - longest in-order subsequence).
+    // --------------------------------------------------------------------------
+    static int lineConflict(const uint8_t* goals, int k) {
+        if (k < 2) return 0;
+        uint8_t lis[N];
+        int best = 0;
+        for (int i = 0; i < k; i++) {
+            lis[i] = 1;
+            for (int j = 0; j < i; j++) {
+                if (goals[j] < goals[i] && lis[j] + 1 > lis[i]) lis[i] = lis[j] + 1;
+            }
+            if (lis[i] > best) best = lis[i];
+        }
+        return 2 * (k - best);
+    }
+
+    static int rowConflict(const Board& b, int r) {
+        uint8_t goals[N];
+        int k = 0;
+        for (int c = 0; c < N; c++) {
+            int t = b.tile(r * N + c);
+            if (t != 0 && (t - 1) / N == r) goals[k++] = (uint8_t)((t - 1) % N);
+        }
+        return lineConflict(goals, k);
+    }
+
+    static int colConflict(const Board& b, int c) {
+        uint8_t goals[N];
+        int k = 0;
+        for (int r = 0; r < N; r++) {
+            int t = b.tile(r * N + c);
+            if (t != 0 && (t - 1) % N == c) goals[k++] = (uint8_t)((t - 1) / N);
+        }
+        return lineConflict(goals, k);
+    }
+
+    void initHeuristic() {
+        lcSum = 0;
+        for (int i = 0; i < N; i++) {
+            lcRow[i] = useLinearConflict ? (uint8_t)rowConflict(board, i) : 0;
+            lcCol[i] = useLinearConflict ? (uint8_t)colConflict(board, i) : 0;
+            lcSum += lcRow[i] + lcCol[i];
+        }
+
+        pdbSum = 0;
+        if constexpr (N == 4) {
+            if (pdb) {
+                for (int p = 0; p < CELLS; p++) tilePos[board.tile(p)] = (uint8_t)p;
+                for (int i = 0; i < pdb->patternCount(); i++) {
+                    pdbExtra[i] = pdb->extra(i, tilePos);
+                    pdbSum += pdbExtra[i];
+                }
+            }
+        }
+    }
+
+    int estimate() const {
+        int extra = lcSum;
+        if (2 * pdbSum > extra) extra = 2 * pdbSum;
+        return board.manhattan() + extra;
+    }
+
+    // Apply move d, updating the heuristic incrementally; state saved in f
+    void apply(MoveDir d, Frame& f) {
+        int e = board.emptyPos();
+        int p = Board::neighbor(e, d);
+        board.slide(d);
+
+        if constexpr (N == 4) {
+            if (pdb) {
+                // Only the moved tile's pattern changes
+                int t = board.tile(e);
+                tilePos[t] = (uint8_t)e;
+                int i = pdb->patternOf(t);
+                if (i >= 0) {
+                    f.savedPdb = pdbExtra[i];
+                    pdbExtra[i] = pdb->extra(i, tilePos);
+                    pdbSum += pdbExtra[i] - f.savedPdb;
+                }
+            }
+        }
+        if (!useLinearConflict) return;
+
+        // A vertical move changes the tile's row, a horizontal one its column
+        uint8_t* lines = (d == MOVE_UP || d == MOVE_DOWN) ? lcRow : lcCol;
+        int a = (d == MOVE_UP || d == MOVE_DOWN) ? Board::row(e) : Board::col(e);
+        int b = (d == MOVE_UP || d == MOVE_DOWN) ? Board::row(p) : Board::col(p);
+        f.savedLcA = lines[a];
+        f.savedLcB = lines[b];
+        lcSum -= lines[a] + lines[b];
+        if (lines == lcRow) {
+            lines[a] = (uint8_t)rowConflict(board, a);
+            lines[b] = (uint8_t)rowConflict(board, b);
+        } else {
+            lines[a] = (uint8_t)colConflict(board, a);
+            lines[b] = (uint8_t)colConflict(board, b);
+        }
+        lcSum += lines[a] + lines[b];
+    }
+
+    void undo(MoveDir d, const Frame& f) {
+        board.slide(oppositeDir(d));
+        int e = board.emptyPos();
+        int p = Board::neighbor(e, d);
+
+        if constexpr (N == 4) {
+            if (pdb) {
+                int t = board.tile(p);
+                tilePos[t] = (uint8_t)p;
+                int i = pdb->patternOf(t);
+                if (i >= 0) {
+                    pdbSum += f.savedPdb - pdbExtra[i];
+                    pdbExtra[i] = f.savedPdb;
+                }
+            }
+        }
+        if (!useLinearConflict) return;
+
+        uint8_t* lines = (d == MOVE_UP || d == MOVE_DOWN) ? lcRow : lcCol;
+        int a = (d == MOVE_UP || d == MOVE_DOWN) ? Board::row(e) : Board::col(e);
+        int b = (d == MOVE_UP || d == MOVE_DOWN) ? Board::row(p) : Board::col(p);
+        lcSum -= lines[a] + lines[b];
+        lines[a] = f.savedLcA;
+        lines[b] = f.savedLcB;
+        lcSum += lines[a] + lines[b];
+    }
+
+public:
+    // Linear conflict on by default; off gives plain Manhattan (benchmarks)
+    void setLinearConflict(bool on) { useLinearConflict = on; }
+
+    // Additive pattern databases (4x4 only; nullptr to disable)
+    void setPatternDatabase(PatternDatabase4x4* db) {
+        if constexpr (N == 4) pdb = (db && db->isLoaded()) ? db : nullptr;
+        else (void)db;
+    }
+
+    static int linearConflict(const Board& b) {
+        int sum = 0;
+        for (int i = 0; i < N; i++) sum += rowConflict(b, i) + colConflict(b, i);
+        return sum;
+    }
+
+    // Admissible estimate of the remaining moves
+    static int heuristic(const Board& b) {
+        return b.manhattan() + linearConflict(b);
+    }
+
+    // Search from start within budget. If path is given, the solution (or the
+    // best partial path) is copied there, up to pathCap moves.
+    SolveResult solve(const Board& start, const SolveBudget& budget,
+                      MoveDir* pathOut = nullptr, int pathCap = 0) {
+        SolveResult res;
+        res.solved = false;
+        res.bestMove = MOVE_NONE;
+        res.hintTilePos = -1;
+        res.solutionLength = -1;
+        res.nodesExpanded = 0;
+        res.elapsedUs = 0;
+        res.nodesPerSecond = 0;
+
+        board = start;
+        initHeuristic();
+        res.lowerBound = estimate();
+
+        unsigned long t0 = micros();
+        unsigned long startMs = millis();
+
+        if (board.isSolved()) {
+            res.solved = true;
+            res.solutionLength = 0;
+            return res;
+        }
+
+        // Anytime fallback: a legal first move in case the budget is tiny
+        MoveDir bestFirst = start.moveAt(0);
+        int bestH = 0x7FFF;
+        int bestDepth = 0;
+        int bestLen = 0;
+        MoveDir bestPath[MAX_DEPTH];
+
+        SolveCount nodes = 0;
+        bool outOfBudget = false;
+        int bound = estimate();
+
+        while (!res.solved && !outOfBudget) {
+            int nextBound = 0x7FFF;
+            int depth = 0;
+            frames[0].nextMove = 0;
+
+            while (true) {
+                Frame& f = frames[depth];
+
+                if (f.nextMove >= board.moveCount()) {
+                    // All children tried: backtrack
+                    if (depth == 0) break;
+                    depth--;
+                    undo(path[depth], frames[depth]);
+                    continue;
+                }
+
+                MoveDir d = board.moveAt(f.nextMove++);
+                if (depth > 0 && d == oppositeDir(path[depth - 1])) continue;
+
+                apply(d, f);
+                nodes++;
+
+                int h = estimate();
+                int fCost = depth + 1 + h;
+                if (fCost > bound) {
+                    if (fCost < nextBound) nextBound = fCost;
+                    undo(d, f);
+                } else {
+                    path[depth] = d;
+                    depth++;
+
+                    if (h < bestH || (h == bestH && depth < bestDepth)) {
+                        bestH = h;
+                        bestDepth = depth;
+                        bestFirst = path[0];
+                        if (pathOut) {
+                            bestLen = depth;
+                            memcpy(bestPath, path, depth * sizeof(MoveDir));
+                        }
+                    }
+
+                    if (h == 0) {
+                        res.solved = true;
+                        res.solutionLength = depth;
+                        break;
+                    }
+
+                    frames[depth].nextMove = 0;
+                }
+
+                // Budget checks (time is sampled to keep millis() off the hot path)
+                if (budget.maxNodes && nodes >= budget.maxNodes) {
+                    outOfBudget = true;
+                    break;
+                }
+                if (budget.maxMillis && (nodes & 1023) == 0 &&
+                    millis() - startMs >= budget.maxMillis) {
+                    outOfBudget = true;
+                    break;
+                }
+            }
+
+            if (res.solved || outOfBudget) break;
+            // Unsolvable, or deeper than the path buffers can hold (depth <= bound)
+            if (nextBound > MAX_DEPTH) break;
+            bound = nextBound;
+            res.lowerBound = bound;
+        }
+
+        if (res.solved) {
+            res.bestMove = path[0];
+            if (pathOut) {
+                int n = res.solutionLength < pathCap ? res.solutionLength : pathCap;
+                memcpy(pathOut, path, n * sizeof(MoveDir));
+            }
+        } else {
+            res.bestMove = bestFirst;
+            if (pathOut) {
+                int n = bestLen < pathCap ? bestLen : pathCap;
+                memcpy(pathOut, bestPath, n * sizeof(MoveDir));
+            }
+        }
+        res.hintTilePos = Board::neighbor(start.emptyPos(), res.bestMove);
+
+        res.nodesExpanded = nodes;
+        res.elapsedUs = (SolveCount)(micros() - t0);
+        res.nodesPerSecond = res.elapsedUs ? (uint32_t)((uint64_t)nodes * 1000000ULL / res.elapsedUs) : 0;
+        return res;
+    }
+};
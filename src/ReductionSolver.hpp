@@ -0,0 +1,205 @@
+#pragma once
+
+#include <Arduino.h>
+#include "PuzzleBoard.hpp"
+#include "PuzzleSolver.hpp"
+#include "HintTable3x3.hpp"
+
+// ==============================================================================
+// ReductionSolver<N>
+// Near-optimal solutions with a hard worst-case cost, for boards too large to
+// solve optimally on the device (5x5, and 4x4 without pattern databases).
+//
+// The board is reduced one line at a time: top row, then left column, then
+// the next row and column, until a 3x3 remains in the bottom-right corner,
+// which is solved optimally (HintTable3x3 or IDA*). Each tile is placed by a
+// BFS over (tile, blank) with finished cells locked; the last two tiles of a
+// line are placed together by a BFS over (tile, tile, blank), since placing
+// them one by one would disturb the first. Other tiles are indistinct, so a
+// pair search has at most N^6 states (15,625 on 5x5), and a whole solve is a
+// fixed number of searches: the cost does not depend on the scramble.
+// ==============================================================================
+
+template <int N>
+class ReductionSolver {
+    static_assert(N >= 4, "3x3 is solved optimally");
+
+public:
+    static constexpr int CELLS = N * N;
+    static constexpr int MAX_PATH = 512;        // Longest 5x5 plan seen is ~260 moves
+
+    struct Stats {
+        uint32_t searches;          // BFS runs (one per tile or tile pair)
+        uint32_t statesExpanded;
+        uint32_t elapsedUs;
+        int length;                 // Moves in the plan (-1 on failure)
+    };
+
+private:
+    using Board = PuzzleBoard<N>;
+    static constexpr int STATES = CELLS * CELLS * CELLS;
+    static constexpr uint8_t UNSEEN = 0xFF;
+    static constexpr uint8_t START = 0xFE;
+
+    uint8_t parent[STATES];         // MoveDir that reached each state
+    uint16_t queue[STATES];
+    PuzzleSolver<3> solver3;
+    const HintTable3x3* table3 = nullptr;
+    Stats stats = {};
+
+    static int encode(int blank, int a, int b) { return blank + CELLS * (a + CELLS * b); }
+
+    // Move the empty cell until tileA (and tileB, if nonzero) are home, never
+    // entering a locked cell. Appends the moves to path; returns the new
+    // length, or -1 if the plan would overflow cap.
+    int place(Board& board, int tileA, int tileB, uint32_t locked, MoveDir* path, int len, int cap) {
+        int goalA = tileA - 1;
+        int goalB = tileB ? tileB - 1 : 0;
+        int a = -1, b = 0;
+        for (int p = 0; p < CELLS; p++) {
+            if (board.tile(p) == tileA) a = p;
+            if (tileB && board.tile(p) == tileB) b = p;
+        }
+
+        stats.searches++;
+        memset(parent, UNSEEN, sizeof(parent));
+        int start = encode(board.emptyPos(), a, b);
+        parent[start] = START;
+        queue[0] = (uint16_t)start;
+        int head = 0, tail = 1;
+        int goal = -1;
+
+        while (head < tail) {
+            int s = queue[head++];
+            int blank = s % CELLS;
+            int pa = (s / CELLS) % CELLS;
+            int pb = s / (CELLS * CELLS);
+            stats.statesExpanded++;
+
+            if (pa == goalA && pb == goalB) {
+                goal = s;
+                break;
+            }
+
+            for (int d = 0; d < 4; d++) {
+                int q = Board::neighbor(blank, (MoveDir)d);
+                if (q < 0 || (locked & (1u << q))) continue;
+                // The tile at q (tracked or not) slides into the old blank
+                int na = (pa == q) ? blank : pa;
+                int nb = (tileB && pb == q) ? blank : pb;
+                int n = encode(q, na, nb);
+                if (parent[n] != UNSEEN) continue;
+                parent[n] = (uint8_t)d;
+                queue[tail++] = (uint16_t)n;
+            }
+        }
+        if (goal < 0) return -1;
+
+        // Walk back to the start, then replay forwards
+        int steps = 0;
+        for (int s = goal; parent[s] != START; steps++) {
+            MoveDir d = (MoveDir)parent[s];
+            int blank = s % CELLS;
+            int pa = (s / CELLS) % CELLS;
+            int pb = s / (CELLS * CELLS);
+            int prev = Board::neighbor(blank, oppositeDir(d));
+            s = encode(prev, (pa == prev) ? blank : pa, (tileB && pb == prev) ? blank : pb);
+            if (len + steps >= cap) return -1;
+            path[len + steps] = d;
+        }
+        for (int i = 0, j = steps - 1; i < j; i++, j--) {
+            MoveDir t = path[len + i];
+            path[len + i] = path[len + j];
+            path[len + j] = t;
+        }
+        for (int i = 0; i < steps; i++) board.slide(path[len + i]);
+        return len + steps;
+    }
+
+    // Solve the bottom-right 3x3 of a board whose other lines are done
+    int finish(Board& board, MoveDir* path, int len, int cap) {
+        const int k = N - 3;
+        uint8_t values[9];
+        for (int r = 0; r < 3; r++) {
+            for (int c = 0; c < 3; c++) {
+                int t = board.tile((r + k) * N + (c + k));
+                if (t == 0) {
+                    values[r * 3 + c] = 0;
+                } else {
+                    int gr = (t - 1) / N - k;
+                    int gc = (t - 1) % N - k;
+                    if (gr < 0 || gc < 0) return -1;
+                    values[r * 3 + c] = (uint8_t)(gr * 3 + gc + 1);
+                }
+            }
+        }
+        PuzzleBoard<3> sub;
+        sub.setTiles(values);
+        if (!sub.isSolvable()) return -1;
+
+        MoveDir moves[32];
+        int n = (table3 && table3->isLoaded()) ? table3->solution(sub, moves, 32) : -1;
+        if (n < 0) {
+            SolveBudget unlimited = {0, 0};
+            SolveResult r = solver3.solve(sub, unlimited, moves, 32);
+            n = r.solutionLength;
+        }
+        if (n < 0 || len + n > cap) return -1;
+
+        // Directions are the same on the sub-board and the full board
+        for (int i = 0; i < n; i++) {
+            path[len + i] = moves[i];
+            board.slide(moves[i]);
+        }
+        return len + n;
+    }
+
+public:
+    void setTable3(const HintTable3x3* table) { table3 = table; }
+
+    const Stats& getStats() const { return stats; }
+
+    // Plan a full solution into path (up to cap moves). Returns its length,
+    // or -1 if the board is unsolvable or the plan does not fit.
+    int solve(const Board& start, MoveDir* path, int cap) {
+        unsigned long t0 = micros();
+        stats = {};
+
+        Board board = start;
+        int len = board.isSolvable() ? 0 : -1;
+        uint32_t locked = 0;
+
+        for (int k = 0; k < N - 3 && len >= 0; k++) {
+            // Row k: cells (k, k..N-1), the last two as a pair
+            for (int c = k; c < N - 2 && len >= 0; c++) {
+                int cell = k * N + c;
+                len = place(board, cell + 1, 0, locked, path, len, cap);
+                locked |= 1u << cell;
+            }
+            if (len >= 0) {
+                int cell = k * N + N - 2;
+                len = place(board, cell + 1, cell + 2, locked, path, len, cap);
+                locked |= 3u << cell;
+            }
+
+            // Column k: cells (k+1..N-1, k), the last two as a pair
+            for (int r = k + 1; r < N - 2 && len >= 0; r++) {
+                int cell = r * N + k;
+                len = place(board, cell + 1, 0, locked, path, len, cap);
+                locked |= 1u << cell;
+            }
+            if (len >= 0) {
+                int cellA = (N - 2) * N + k;
+                int cellB = (N - 1) * N + k;
+                len = place(board, cellA + 1, cellB + 1, locked, path, len, cap);
+                locked |= (1u << cellA) | (1u << cellB);
+            }
+        }
+        if (len >= 0) len = finish(board, path, len, cap);
+        if (len >= 0 && !board.isSolved()) len = -1;
+
+        stats.length = len;
+        stats.elapsedUs = (uint32_t)(micros() - t0);
+        return len;
+    }
+};
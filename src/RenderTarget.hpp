@@ -0,0 +1,55 @@
+#pragma once
+
+#include <Arduino.h>
+
+// ==============================================================================
+// RenderTarget
+// The drawing operations the screens use, so the same screen code can draw to
+// the panel or the compositor's back buffer (LGFXTarget, src/LGFXTarget.hpp)
+// and, on Linux, to an in-memory framebuffer (src/native/FrameBufferTarget.hpp)
+// that can be dumped to PPM and compared pixel for pixel.
+//
+// Colors are plain RGB565, as passed to LovyanGFX fillRect; pushImage data is
+// the panel's byte-swapped RGB565 (docs/COLOR_FORMAT.md). Text uses the 6x8
+// built-in font scaled by setTextSize.
+// ==============================================================================
+
+enum TextAlign {
+    TEXT_TOP_LEFT,
+    TEXT_MIDDLE_LEFT,
+    TEXT_MIDDLE_CENTER,
+    TEXT_MIDDLE_RIGHT
+};
+
+class RenderTarget {
+public:
+    virtual ~RenderTarget() {}
+
+    virtual int width() const = 0;
+    virtual int height() const = 0;
+
+    // Byte-swapped pixels, width() per row, when the target is plain memory
+    // (back buffers, host framebuffers); nullptr for a panel
+    virtual uint16_t* buffer() { return nullptr; }
+
+    // Batching (a bus transaction on the panel; no-op in memory)
+    virtual void startWrite() {}
+    virtual void endWrite() {}
+
+    virtual void setClipRect(int x, int y, int w, int h) = 0;
+    virtual void clearClipRect() = 0;
+    virtual void getClipRect(int& x, int& y, int& w, int& h) const = 0;
+
+    virtual void fillScreen(uint16_t color) = 0;
+    virtual void fillRect(int x, int y, int w, int h, uint16_t color) = 0;
+    virtual void drawRect(int x, int y, int w, int h, uint16_t color) = 0;
+    virtual void fillRoundRect(int x, int y, int w, int h, int r, uint16_t color) = 0;
+    virtual void drawRoundRect(int x, int y, int w, int h, int r, uint16_t color) = 0;
+    virtual void drawLine(int x0, int y0, int x1, int y1, uint16_t color) = 0;
+    virtual void pushImage(int x, int y, int w, int h, const uint16_t* data) = 0;
+
+    virtual void setTextColor(uint16_t color) = 0;
+    virtual void setTextAlign(TextAlign align) = 0;
+    virtual void setTextSize(int size) = 0;
+    virtual void drawString(const char* text, int x, int y) = 0;
+};
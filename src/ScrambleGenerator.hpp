@@ -0,0 +1,224 @@
+#pragma once
+
+#include <Arduino.h>
+#include "SlidingPuzzle.hpp"
+#include "HintEngine.hpp"
+#include "PuzzleRandom.hpp"
+
+// ==============================================================================
+// ScrambleGenerator
+// Produces boards whose *optimal* solution length lies in a requested range
+// (e.g. 3x3 with 18-22 moves), so difficulty means more than grid size.
+// Candidates are non-backtracking random walks whose length adapts toward the
+// range; each is verified by the HintEngine (IDA* under a node budget, or the
+// 3x3 lookup table). The search stops on a node budget, never on the clock,
+// and everything is driven by PuzzleRandom, so a seed always yields the same
+// board on any CPU (for the same solver tables). Boards that landed in range
+// are cached per seed: Restart replays from the cache and the win screen
+// prepares the next board ahead of Play Again. A search that ran out of
+// budget keeps its closest verified candidate and is not cached.
+// ==============================================================================
+
+struct ScrambleSpec {
+    uint8_t minOptimal;     // Inclusive range for the optimal solution length
+    uint8_t maxOptimal;
+    uint32_t nodesPerCandidate;     // Solver budget for verifying one candidate (0: none)
+    uint32_t maxNodes;      // Budget for the whole search, at least 1 per candidate (keep best)
+};
+
+class ScrambleGenerator {
+public:
+    static const int CACHE_SIZE = 8;
+
+    // Ranges picked from measured node counts (host bench, 500 seeds each;
+    // node counts do not depend on the CPU). Searches needing more than
+    // SEARCH_NODES: 3x3 none, 4x4 24-30 under 1%, 5x5 28-34 about 1%. The
+    // previous 4x4 30-36 and 5x5 36-42 took up to 430k and 860k nodes.
+    static const uint32_t SEARCH_NODES = 100000;
+
+    static ScrambleSpec defaultSpec(int gridSize) {
+        switch (gridSize) {
+            case 3:  return {18, 22, 0, SEARCH_NODES};
+            case 4:  return {24, 30, 10000, SEARCH_NODES};
+            default: return {28, 34, 10000, SEARCH_NODES};
+        }
+    }
+
+    struct Stats {
+        uint32_t cacheHits;
+        uint32_t cacheMisses;
+        uint32_t candidates;        // Candidates tried by the last generate()
+        uint32_t nodes;             // Solver nodes spent by the last generate()
+        uint32_t elapsedMs;         // Wall time of the last generate()
+        bool budgetHit;             // The last generate() ran out of nodes
+    };
+
+private:
+    struct Entry {
+        bool valid;
+        uint8_t gridSize;
+        uint8_t minOptimal;
+        uint8_t maxOptimal;
+        uint32_t seed;
+        int16_t optimal;
+        uint8_t tiles[25];
+    };
+
+    HintEngine& engine;
+    Entry cache[CACHE_SIZE];
+    Entry uncached;                 // Last result that ran out of budget
+    int nextSlot = 0;
+    Stats stats = {};
+
+    Entry* lookup(int gridSize, uint32_t seed, const ScrambleSpec& spec) {
+        for (Entry& e : cache) {
+            if (e.valid && e.gridSize == gridSize && e.seed == seed &&
+                e.minOptimal == spec.minOptimal && e.maxOptimal == spec.maxOptimal) {
+                return &e;
+            }
+        }
+        return nullptr;
+    }
+
+    // True if the board landed in range; false if the node budget ran out
+    // first (out holds the closest verified candidate, or optimal -1)
+    template <int N>
+    bool build(Entry& out, uint32_t seed, const ScrambleSpec& spec) {
+        PuzzleRandom rng(seed);
+        uint32_t spent = 0;
+
+        int target = (spec.minOptimal + spec.maxOptimal) / 2;
+        int walkLen = target + target / 2;
+        int bestDiff = 0x7FFF;
+
+        PuzzleBoard<N> best = PuzzleBoard<N>::solved();
+        int bestOptimal = -1;
+
+        while (true) {
+            // Non-backtracking walk from the goal
+            PuzzleBoard<N> board = PuzzleBoard<N>::solved();
+            MoveDir last = MOVE_NONE;
+            for (int i = 0; i < walkLen; i++) {
+                MoveDir d;
+                do {
+                    d = board.moveAt((int)rng.below((uint32_t)board.moveCount()));
+                } while (last != MOVE_NONE && d == oppositeDir(last));
+                board.slide(d);
+                last = d;
+            }
+
+            // Each verification gets its own budget, capped by what is left
+            uint32_t left = spec.maxNodes ? spec.maxNodes - spent : 0;
+            uint32_t cap = spec.nodesPerCandidate;
+            if (left && (!cap || left < cap)) cap = left;
+            SolveBudget budget = {0, cap};
+
+            stats.candidates++;
+            // A table lookup (3x3) expands no nodes: charge one per candidate
+            // so the budget also bounds a range the walks can never reach
+            SolveResult r = engine.solve(board, budget);
+            spent += r.nodesExpanded ? (uint32_t)r.nodesExpanded : 1;
+            stats.nodes += r.nodesExpanded;
+
+            if (r.solved && !board.isSolved()) {
+                int len = r.solutionLength;
+                int diff = len < spec.minOptimal ? spec.minOptimal - len
+                         : len > spec.maxOptimal ? len - spec.maxOptimal : 0;
+                if (diff < bestDiff) {
+                    bestDiff = diff;
+                    best = board;
+                    bestOptimal = len;
+                }
+                if (diff == 0) break;
+
+                // Steer the walk length toward the range
+                if (len < spec.minOptimal) walkLen += spec.minOptimal - len + 1;
+                else walkLen -= len - spec.maxOptimal;
+            } else if (!r.solved) {
+                // Too hard to verify within budget: walk less far
+                walkLen -= 2;
+            }
+            if (walkLen < spec.minOptimal) walkLen = spec.minOptimal;
+
+            if (spec.maxNodes && spent >= spec.maxNodes) {
+                if (bestOptimal < 0) {
+                    // Nothing verified: keep the last candidate, length unknown
+                    best = board;
+                }
+                break;
+            }
+        }
+
+        for (int p = 0; p < N * N; p++) out.tiles[p] = (uint8_t)best.tile(p);
+        out.optimal = (int16_t)bestOptimal;
+        return bestDiff == 0;
+    }
+
+public:
+    explicit ScrambleGenerator(HintEngine& hintEngine) : engine(hintEngine) {
+        for (Entry& e : cache) e.valid = false;
+    }
+
+    // Generate (or find cached) the board for seed without applying it
+    int prepare(int gridSize, uint32_t seed, const ScrambleSpec& spec) {
+        return find(gridSize, seed, spec).optimal;
+    }
+
+    int prepare(int gridSize, uint32_t seed) {
+        return prepare(gridSize, seed, defaultSpec(gridSize));
+    }
+
+    // Scramble puzzle to a board with optimal length in spec's range.
+    // Returns the optimal length, or -1 if the node budget ran out before any
+    // candidate verified.
+    int generate(SlidingPuzzle& puzzle, uint32_t seed, const ScrambleSpec& spec) {
+        const Entry& e = find(puzzle.getGridSize(), seed, spec);
+        puzzle.loadScramble(e.tiles, seed, e.optimal);
+        return e.optimal;
+    }
+
+    int generate(SlidingPuzzle& puzzle, uint32_t seed) {
+        return generate(puzzle, seed, defaultSpec(puzzle.getGridSize()));
+    }
+
+    const Stats& getStats() const { return stats; }
+
+private:
+    const Entry& find(int n, uint32_t seed, const ScrambleSpec& spec) {
+        Entry* e = lookup(n, seed, spec);
+
+        if (e) {
+            stats.cacheHits++;
+        } else {
+            stats.cacheMisses++;
+            stats.candidates = 0;
+            stats.nodes = 0;
+            unsigned long t0 = millis();
+
+            Entry built = {};
+            built.gridSize = (uint8_t)n;
+            built.minOptimal = spec.minOptimal;
+            built.maxOptimal = spec.maxOptimal;
+            built.seed = seed;
+            bool inRange;
+            switch (n) {
+                case 3:  inRange = build<3>(built, seed, spec); break;
+                case 4:  inRange = build<4>(built, seed, spec); break;
+                default: inRange = build<5>(built, seed, spec); break;
+            }
+            stats.budgetHit = !inRange;
+
+            // Only boards that landed in range are kept for Restart/Play Again
+            if (inRange) {
+                built.valid = true;
+                e = &cache[nextSlot];
+                nextSlot = (nextSlot + 1) % CACHE_SIZE;
+            } else {
+                e = &uncached;
+            }
+            *e = built;
+            stats.elapsedMs = millis() - t0;
+        }
+        return *e;
+    }
+};
@@ -1,15 +1,25 @@
 #pragma once
 
 #include <Arduino.h>
-#include <vector>
-#include <algorithm>
-
+#include "PuzzleBoard.hpp"
+#include "PuzzleRandom.hpp"
+
+// ==============================================================================
+// SlidingPuzzle
+// Runtime-sized game state. The board itself is a PuzzleBoard<3/4/5>; this
+// class only dispatches on gridSize and tracks moves, timer and win state.
+// ==============================================================================
 class SlidingPuzzle {
 private:
-    std::vector<int> tiles;     // Tile positions (0 = empty)
+    union {
+        PuzzleBoard<3> board3;
+        PuzzleBoard<4> board4;
+        PuzzleBoard<5> board5;
+    };
     int gridSize;                // 3, 4, or 5
-    int emptyPos;                // Position of empty tile
     int moveCount;
+    uint32_t scrambleSeed;       // Seed of the last scramble (0 = random walk)
+    int optimalLength;           // Optimal solution length of the scramble (-1 = unknown)
     unsigned long startTime;
     bool gameWon;
     bool gameStarted;
@@ -19,70 +29,51 @@ private:
         return row * gridSize + col;
     }
 
-    // Helper: Get row from position
-    int row(int p) const {
-        return p / gridSize;
-    }
+    // Bookkeeping shared by moveTile() and moveLine()
+    void countMoves(int count) {
+        // Start timer on first move
+        if (!gameStarted) {
+            gameStarted = true;
+            startTime = millis();
+        }
 
-    // Helper: Get col from position
-    int col(int p) const {
-        return p % gridSize;
-    }
+        moveCount += count;
 
-    // Check if puzzle is currently solved
-    bool checkWinCondition() {
-        for (int i = 0; i < tiles.size() - 1; i++) {
-            if (tiles[i] != i + 1) return false;
+        // Check win condition
+        if (isSolved()) {
+            gameWon = true;
         }
-        return tiles[tiles.size() - 1] == 0;  // Empty tile at end
     }
 
-    // Count inversions (for solvability check)
-    int countInversions() const {
-        int inv = 0;
-        for (int i = 0; i < tiles.size() - 1; i++) {
-            if (tiles[i] == 0) continue;
-            for (int j = i + 1; j < tiles.size(); j++) {
-                if (tiles[j] == 0) continue;
-                if (tiles[i] > tiles[j]) inv++;
-            }
-        }
-        return inv;
+public:
+    SlidingPuzzle(int size = 3)
+        : gridSize(size < 3 ? 3 : size > 5 ? 5 : size), moveCount(0), scrambleSeed(0),
+          optimalLength(-1), gameWon(false), gameStarted(false) {
+        reset();
     }
 
-    // Check if current configuration is solvable
-    bool isSolvable() const {
-        int inv = countInversions();
-
-        if (gridSize % 2 == 1) {
-            // Odd grid: solvable if inversions are even
-            return (inv % 2 == 0);
-        } else {
-            // Even grid: solvable if (inversions + empty row from bottom) is odd
-            int emptyRow = row(emptyPos);
-            int emptyRowFromBottom = gridSize - emptyRow;
-            return ((inv + emptyRowFromBottom) % 2 == 1);
+    // Run f on the concrete PuzzleBoard<N> (f must accept any board type)
+    template <typename F>
+    decltype(auto) visit(F&& f) {
+        switch (gridSize) {
+            case 3:  return f(board3);
+            case 4:  return f(board4);
+            default: return f(board5);
         }
     }
 
-public:
-    SlidingPuzzle(int size = 3) : gridSize(size), moveCount(0), gameWon(false), gameStarted(false) {
-        reset();
+    template <typename F>
+    decltype(auto) visit(F&& f) const {
+        switch (gridSize) {
+            case 3:  return f(board3);
+            case 4:  return f(board4);
+            default: return f(board5);
+        }
     }
 
     // Initialize puzzle in solved state
     void reset() {
-        int totalTiles = gridSize * gridSize;
-        tiles.clear();
-        tiles.reserve(totalTiles);
-
-        // Fill tiles 1 to N-1, then 0 (empty)
-        for (int i = 1; i < totalTiles; i++) {
-            tiles.push_back(i);
-        }
-        tiles.push_back(0);  // Empty tile at end
-
-        emptyPos = totalTiles - 1;
+        visit([](auto& b) { b.reset(); });
         moveCount = 0;
         gameWon = false;
         gameStarted = false;
@@ -92,76 +83,84 @@ public:
     // Shuffle puzzle with guaranteed solvable configuration
     void shuffle(int numMoves = 100) {
         // Use random moves from solved state to ensure solvability
-        for (int i = 0; i < numMoves; i++) {
-            std::vector<int> validMoves;
-
-            int emptyRow = row(emptyPos);
-            int emptyCol = col(emptyPos);
-
-            // Check all 4 directions
-            if (emptyRow > 0) validMoves.push_back(pos(emptyRow - 1, emptyCol));  // Up
-            if (emptyRow < gridSize - 1) validMoves.push_back(pos(emptyRow + 1, emptyCol));  // Down
-            if (emptyCol > 0) validMoves.push_back(pos(emptyRow, emptyCol - 1));  // Left
-            if (emptyCol < gridSize - 1) validMoves.push_back(pos(emptyRow, emptyCol + 1));  // Right
-
-            if (!validMoves.empty()) {
-                int randomMove = validMoves[random(validMoves.size())];
-                // Swap with empty (no move count increase during shuffle)
-                std::swap(tiles[emptyPos], tiles[randomMove]);
-                emptyPos = randomMove;
+        visit([numMoves](auto& b) {
+            for (int i = 0; i < numMoves; i++) {
+                b.slide(b.moveAt(random(b.moveCount())));
             }
-        }
+        });
 
         // Reset counters after shuffle
+        scrambleSeed = 0;
+        optimalLength = -1;
         moveCount = 0;
         gameWon = false;
         gameStarted = false;
     }
 
-    // Check if a tile at given position can move
-    bool canMove(int tilePos) const {
-        if (tilePos < 0 || tilePos >= tiles.size()) return false;
-        if (tiles[tilePos] == 0) return false;  // Can't move empty tile
+    // Uniformly random solvable board, reproducible from seed, O(n) for any
+    // difficulty (replaces the random walk, which undoes itself on 5x5)
+    void shuffleUniform(uint32_t seed) {
+        PuzzleRandom rng(seed);
+        visit([&rng](auto& b) { b.scramble(rng); });
 
-        int tileRow = row(tilePos);
-        int tileCol = col(tilePos);
-        int emptyRow = row(emptyPos);
-        int emptyCol = col(emptyPos);
+        scrambleSeed = seed;
+        optimalLength = -1;
+        moveCount = 0;
+        gameWon = false;
+        gameStarted = false;
+    }
 
-        // Check if adjacent to empty
-        bool adjacent = (abs(tileRow - emptyRow) == 1 && tileCol == emptyCol) ||
-                       (abs(tileCol - emptyCol) == 1 && tileRow == emptyRow);
+    // Start from a prepared arrangement (see ScrambleGenerator)
+    void loadScramble(const uint8_t* tiles, uint32_t seed, int optimal) {
+        visit([tiles](auto& b) { b.setTiles(tiles); });
 
-        return adjacent;
+        scrambleSeed = seed;
+        optimalLength = optimal;
+        moveCount = 0;
+        gameWon = false;
+        gameStarted = false;
+        startTime = 0;
+    }
+
+    // Check if a tile at given position can move
+    bool canMove(int tilePos) const {
+        return visit([tilePos](const auto& b) { return b.canMove(tilePos); });
     }
 
     // Move tile at position (if valid)
     bool moveTile(int tilePos) {
-        if (!canMove(tilePos)) return false;
-
-        // Start timer on first move
-        if (!gameStarted) {
-            gameStarted = true;
-            startTime = millis();
-        }
-
-        // Swap tile with empty
-        std::swap(tiles[emptyPos], tiles[tilePos]);
-        emptyPos = tilePos;
-        moveCount++;
+        if (!visit([tilePos](auto& b) { return b.moveTile(tilePos); })) return false;
+        countMoves(1);
+        return true;
+    }
 
-        // Check win condition
-        if (checkWinCondition()) {
-            gameWon = true;
-        }
+    // Tiles a tap at tilePos would shift: the run from tilePos up to the
+    // empty slot when they share a row or column, else 0
+    int lineLength(int tilePos) const {
+        if (tilePos < 0 || tilePos >= gridSize * gridSize) return 0;
+        int e = getEmptyPos();
+        if (tilePos / gridSize == e / gridSize) return abs(tilePos - e);
+        if (tilePos % gridSize == e % gridSize) return abs(tilePos - e) / gridSize;
+        return 0;
+    }
 
-        return true;
+    // Shift the whole run between tilePos and the empty slot one cell toward
+    // the slot; each tile counts as a move. Returns the number of tiles moved.
+    int moveLine(int tilePos) {
+        int count = lineLength(tilePos);
+        if (count == 0) return 0;
+        int step = (tilePos - getEmptyPos()) / count;       // +-1 or +-gridSize
+        visit([tilePos, step](auto& b) {
+            while (b.emptyPos() != tilePos) b.moveTile(b.emptyPos() + step);
+        });
+        countMoves(count);
+        return count;
     }
 
     // Get tile number at position (0 = empty)
     int getTile(int pos) const {
-        if (pos < 0 || pos >= tiles.size()) return -1;
-        return tiles[pos];
+        if (pos < 0 || pos >= gridSize * gridSize) return -1;
+        return visit([pos](const auto& b) { return b.tile(pos); });
     }
 
     // Get tile number at row/col
@@ -169,10 +168,34 @@ public:
         return getTile(pos(r, c));
     }
 
+    // Tile the empty slot would swap with moving in direction d (-1 at an edge)
+    int getNeighborPos(MoveDir d) const {
+        return visit([d](const auto& b) { return b.canSlide(d) ? b.neighbor(b.emptyPos(), d) : -1; });
+    }
+
+    bool isSolved() const {
+        return visit([](const auto& b) { return b.isSolved(); });
+    }
+
+    bool isSolvable() const {
+        return visit([](const auto& b) { return b.isSolvable(); });
+    }
+
+    // Distance-to-solved measures, tracked per move (O(1))
+    int getManhattanDistance() const {
+        return visit([](const auto& b) { return b.manhattan(); });
+    }
+
+    int getMisplacedCount() const {
+        return visit([](const auto& b) { return b.misplacedCount(); });
+    }
+
     // Getters
     int getGridSize() const { return gridSize; }
     int getMoveCount() const { return moveCount; }
-    int getEmptyPos() const { return emptyPos; }
+    uint32_t getScrambleSeed() const { return scrambleSeed; }
+    int getOptimalLength() const { return optimalLength; }
+    int getEmptyPos() const { return visit([](const auto& b) { return b.emptyPos(); }); }
     bool isWon() const { return gameWon; }
     bool hasStarted() const { return gameStarted; }
 
@@ -197,6 +220,6 @@ public:
             Serial.println();
         }
         Serial.printf("Moves: %d, Empty: %d, Won: %s\n",
-                     moveCount, emptyPos, gameWon ? "YES" : "NO");
+                     moveCount, getEmptyPos(), gameWon ? "YES" : "NO");
     }
 };
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <Arduino.h>
+#include <string.h>
+#include "RenderTarget.hpp"
+#include "Blitter.hpp"
+#include "GameScreens.hpp"
+
+// ==============================================================================
+// StatusBar
+// Character-level updates of the status bar. The bar's font is fixed (the
+// built-in 6x8 font at STATUS_TEXT_SIZE, monospaced), so every character sits
+// in its own cell: the glyph atlas holds each character the bar can show,
+// pre-rasterized white on black, and update() re-blits only the cells whose
+// character changed. A timer tick is usually one 12x16 cell (192 px) instead
+// of clearing and redrawing the 480x40 bar (19,200 px).
+//
+// "Moves: N" grows to the right from STATUS_LEFT_X; "Time: MM:SS" is
+// right-aligned at STATUS_RIGHT_X, so its cells are matched from the right.
+// A full GameScreens::statusBar() draw must be reported with shown() before
+// update() can diff against it.
+// ==============================================================================
+
+class GlyphAtlas {
+private:
+    uint16_t* pixels = nullptr;
+    const char* charset = nullptr;
+    int count = 0;
+    int cellW = 0;
+    int cellH = 0;
+
+public:
+    ~GlyphAtlas() { release(); }
+
+    void release() {
+        if (pixels) free(pixels);
+        pixels = nullptr;
+        count = 0;
+    }
+
+    bool isReady() const { return pixels != nullptr; }
+    int getCellWidth() const { return cellW; }
+    int getCellHeight() const { return cellH; }
+
+    // Rasterize chars (a string literal; kept by pointer) in the built-in font
+    // at textSize through scratch, a memory target of at least
+    // strlen(chars) * 6 * textSize by 8 * textSize pixels
+    bool build(RenderTarget& scratch, const char* chars, int textSize, uint16_t fg, uint16_t bg) {
+        release();
+        int n = (int)strlen(chars);
+        int w = 6 * textSize, h = 8 * textSize;
+        if (!scratch.buffer() || scratch.width() < n * w || scratch.height() < h) return false;
+
+        pixels = (uint16_t*)ps_malloc((size_t)n * w * h * sizeof(uint16_t));
+        if (!pixels) return false;
+        charset = chars;
+        count = n;
+        cellW = w;
+        cellH = h;
+
+        // The font is monospaced: one string, then cut it into cells
+        scratch.fillRect(0, 0, n * w, h, bg);
+        scratch.setTextColor(fg);
+        scratch.setTextAlign(TEXT_TOP_LEFT);
+        scratch.setTextSize(textSize);
+        scratch.drawString(chars, 0, 0);
+
+        const uint16_t* src = scratch.buffer();
+        int stride = scratch.width();
+        for (int i = 0; i < n; i++) {
+            uint16_t* cell = pixels + (size_t)i * w * h;
+            for (int y = 0; y < h; y++) memcpy(cell + y * w, src + y * stride + i * w, w * sizeof(uint16_t));
+        }
+        return true;
+    }
+
+    // Cell pixels of c, or nullptr if c is not in the atlas
+    const uint16_t* glyph(char c) const {
+        const char* p = c ? strchr(charset, c) : nullptr;
+        return p ? pixels + (size_t)(p - charset) * cellW * cellH : nullptr;
+    }
+};
+
+class StatusBar {
+public:
+    static const int MAX_DIRTY = 2;         // One span per field
+
+    struct Rect {
+        int x, y, w, h;
+    };
+
+private:
+    GlyphAtlas glyphs;
+    char left[STATUS_TEXT_MAX];
+    char right[STATUS_TEXT_MAX];
+    bool showing = false;
+    Rect dirty[MAX_DIRTY];
+    int dirtyCount = 0;
+    uint32_t lastPixels = 0;
+
+    int textY() const { return STATUS_BAR_HEIGHT / 2 - glyphs.getCellHeight() / 2; }
+
+    // Re-blit the cells of one field that differ; false if a glyph is missing
+    bool updateField(Blitter& painter, const char* was, const char* now, bool alignRight) {
+        int cw = glyphs.getCellWidth(), ch = glyphs.getCellHeight();
+        int wasLen = (int)strlen(was), nowLen = (int)strlen(now);
+        int cells = max(wasLen, nowLen);
+        int lo = INT32_MAX, hi = INT32_MIN;
+
+        for (int i = 0; i < cells; i++) {
+            // Cell i counts from the anchor: left to right, or right to left
+            int wi = alignRight ? wasLen - 1 - i : i;
+            int ni = alignRight ? nowLen - 1 - i : i;
+            char a = (wi >= 0 && wi < wasLen) ? was[wi] : ' ';
+            char b = (ni >= 0 && ni < nowLen) ? now[ni] : ' ';
+            if (a == b) continue;
+
+            const uint16_t* g = glyphs.glyph(b);
+            if (!g) return false;
+            int x = alignRight ? STATUS_RIGHT_X - (i + 1) * cw : STATUS_LEFT_X + i * cw;
+            painter.blit(x, textY(), cw, ch, g);
+            lastPixels += (uint32_t)(cw * ch);
+            lo = min(lo, x);
+            hi = max(hi, x + cw);
+        }
+        if (hi > lo) dirty[dirtyCount++] = {lo, textY(), hi - lo, ch};
+        return true;
+    }
+
+public:
+    // Glyphs for every character the bar shows (see GameScreens::statusText)
+    bool begin(RenderTarget& scratch) {
+        bool ok = glyphs.build(scratch, " 0123456789:MovesTim", STATUS_TEXT_SIZE, COL_WHITE, COL_BLACK);
+        Serial.printf("StatusBar: glyph atlas %s\n", ok ? "ready" : "unavailable, full redraws");
+        return ok;
+    }
+
+    bool isReady() const { return glyphs.isReady(); }
+
+    // The bar on screen now shows moves/secs (after a full draw)
+    void shown(int moves, unsigned long secs) {
+        GameScreens::statusText(moves, secs, left, right);
+        showing = true;
+    }
+
+    void invalidate() { showing = false; }
+
+    // Bring the bar from what was shown to moves/secs, cell by cell. Returns
+    // false (nothing drawn) when a full GameScreens::statusBar() is needed.
+    bool update(Blitter& painter, int moves, unsigned long secs) {
+        dirtyCount = 0;
+        lastPixels = 0;
+        if (!showing || !glyphs.isReady()) return false;
+
+        char newLeft[STATUS_TEXT_MAX], newRight[STATUS_TEXT_MAX];
+        GameScreens::statusText(moves, secs, newLeft, newRight);
+
+        Blitter::Frame frame(painter);
+        if (!updateField(painter, left, newLeft, false) ||
+            !updateField(painter, right, newRight, true)) {
+            showing = false;
+            return false;
+        }
+        strcpy(left, newLeft);
+        strcpy(right, newRight);
+        return true;
+    }
+
+    // What the last update() drew
+    int getDirtyCount() const { return dirtyCount; }
+    const Rect& getDirty(int i) const { return dirty[i]; }
+    uint32_t getLastPixels() const { return lastPixels; }
+};
@@ -0,0 +1,203 @@
+#pragma once
+
+#include <Arduino.h>
+#include "PixelKernels.hpp"
+
+// ==============================================================================
+// TileAtlas
+// Pre-scaled tiles for the current puzzle, built once per image load. The
+// 480x480 source has 160/120/96 px tiles while the game area shows them at
+// 130/97/78 px; the atlas stores each tile already scaled (and with its grid
+// border baked in) as one contiguous tileSize x tileSize block in PSRAM, so
+// drawing a tile is a single pushImage with no per-frame scaling or malloc.
+//
+// Pixels stay in the panel's byte-swapped RGB565 (docs/COLOR_FORMAT.md); the
+// box filter unswaps, averages per channel and swaps back.
+//
+// attach() uses tiles that already exist in this layout elsewhere (the
+// memory-mapped asset blob, AssetBlob.hpp) without copying or owning them.
+// ==============================================================================
+
+enum AtlasFilter {
+    ATLAS_NEAREST,      // Same look as the old per-draw scaling
+    ATLAS_BOX           // Area average: no dropped rows/columns when shrinking
+};
+
+class TileAtlas {
+public:
+    static const int IMAGE_SIZE = 480;
+    static const int MAX_TAPS = 4;          // Source pixels per axis per output pixel
+
+private:
+    uint16_t* owned = nullptr;      // Allocated by build()
+    const uint16_t* pixels = nullptr;
+    int gridSize = 0;
+    int tileSize = 0;
+
+    // Area-weighted source taps for one axis: output pixel d covers source
+    // [d * src / dst, (d + 1) * src / dst); weights are in 1/dst pixel units
+    // and sum to src.
+    struct Taps {
+        uint8_t count;
+        uint8_t first;
+        uint16_t weight[MAX_TAPS];
+    };
+
+    // In-progress build (start() .. finish())
+    Taps* taps = nullptr;
+    uint16_t* map = nullptr;
+    int srcSize = 0;
+    AtlasFilter buildFilter = ATLAS_BOX;
+    uint16_t border = 0;
+
+    static void buildTaps(Taps* taps, int src, int dst) {
+        for (int d = 0; d < dst; d++) {
+            int lo = d * src;                 // In units of 1/dst source pixels
+            int hi = lo + src;
+            Taps& t = taps[d];
+            t.first = (uint8_t)(lo / dst);
+            t.count = 0;
+            for (int s = t.first; s * dst < hi && t.count < MAX_TAPS; s++) {
+                int a = s * dst > lo ? s * dst : lo;
+                int b = (s + 1) * dst < hi ? (s + 1) * dst : hi;
+                t.weight[t.count++] = (uint16_t)(b - a);
+            }
+        }
+    }
+
+    void scaleTile(const uint16_t* image, int srcX, int srcY, int srcSize,
+                   uint16_t* out, AtlasFilter filter, const Taps* taps, const uint16_t* map) {
+        if (filter == ATLAS_NEAREST) {
+            PixelKernels::scaleRect(out, tileSize, image + srcY * IMAGE_SIZE + srcX, IMAGE_SIZE,
+                                    map, map, tileSize, tileSize);
+            return;
+        }
+
+        for (int dy = 0; dy < tileSize; dy++) {
+            for (int dx = 0; dx < tileSize; dx++) {
+                const Taps& ty = taps[dy];
+                const Taps& tx = taps[dx];
+                uint32_t r = 0, g = 0, b = 0;
+                for (int j = 0; j < ty.count; j++) {
+                    const uint16_t* row = image + (srcY + ty.first + j) * IMAGE_SIZE + srcX + tx.first;
+                    uint32_t wy = ty.weight[j];
+                    for (int i = 0; i < tx.count; i++) {
+                        uint16_t p = PixelKernels::swap16(row[i]);
+                        uint32_t w = wy * tx.weight[i];
+                        r += (p >> 11) * w;
+                        g += ((p >> 5) & 0x3F) * w;
+                        b += (p & 0x1F) * w;
+                    }
+                }
+                uint32_t total = (uint32_t)srcSize * srcSize;
+                uint16_t p = (uint16_t)((((r + total / 2) / total) << 11) |
+                                        (((g + total / 2) / total) << 5) |
+                                        ((b + total / 2) / total));
+                out[dy * tileSize + dx] = PixelKernels::swap16(p);
+            }
+        }
+    }
+
+public:
+    ~TileAtlas() { release(); }
+
+    void release() {
+        if (owned) free(owned);
+        free(taps);
+        free(map);
+        owned = nullptr;
+        taps = nullptr;
+        map = nullptr;
+        pixels = nullptr;
+        gridSize = 0;
+        tileSize = 0;
+    }
+
+    bool isReady(int grid, int size) const {
+        return pixels && gridSize == grid && tileSize == size;
+    }
+
+    // Scale every tile of image (480x480) to size x size. borderColor (plain
+    // RGB565, as passed to drawRect) is drawn on each tile's edge.
+    bool build(const uint16_t* image, int grid, int size, AtlasFilter filter, uint16_t borderColor) {
+        unsigned long t0 = millis();
+        if (!start(grid, size, filter, borderColor)) return false;
+        for (int cell = 0; cell < grid * grid; cell++) scaleCell(image, cell);
+        finish();
+
+        Serial.printf("TileAtlas: %d tiles of %dx%d (%s) in %lu ms, %u bytes\n",
+                      grid * grid, size, size, filter == ATLAS_BOX ? "box" : "nearest",
+                      millis() - t0, (unsigned)((size_t)grid * grid * size * size * sizeof(uint16_t)));
+        return true;
+    }
+
+    // Incremental build, for callers that spread it over several loop passes:
+    // start(), scaleCell() for cells 0 .. grid^2 - 1, then finish(). The atlas
+    // is not ready until finish().
+    bool start(int grid, int size, AtlasFilter filter, uint16_t borderColor) {
+        release();
+        srcSize = IMAGE_SIZE / grid;
+        if (size <= 0 || size * (MAX_TAPS - 1) < srcSize) return false;
+
+        size_t bytes = (size_t)grid * grid * size * size * sizeof(uint16_t);
+        owned = (uint16_t*)ps_malloc(bytes);
+        if (!owned) {
+            Serial.printf("TileAtlas: no PSRAM for %u bytes\n", (unsigned)bytes);
+            return false;
+        }
+        taps = (Taps*)malloc(size * sizeof(Taps));
+        map = (uint16_t*)malloc(size * sizeof(uint16_t));
+        if (!taps || !map) {
+            release();
+            return false;
+        }
+        gridSize = grid;
+        tileSize = size;
+        buildFilter = filter;
+        buildTaps(taps, srcSize, size);
+        PixelKernels::buildScaleMap(map, srcSize, size);
+        border = PixelKernels::swap16(borderColor);
+        return true;
+    }
+
+    // Tile N is cell N-1 of the solved image
+    void scaleCell(const uint16_t* image, int cell) {
+        int size = tileSize;
+        uint16_t* out = owned + (size_t)cell * size * size;
+        scaleTile(image, (cell % gridSize) * srcSize, (cell / gridSize) * srcSize, srcSize,
+                  out, buildFilter, taps, map);
+
+        // Grid border, as drawTile() used to draw after every blit
+        for (int i = 0; i < size; i++) {
+            out[i] = border;
+            out[(size - 1) * size + i] = border;
+            out[i * size] = border;
+            out[i * size + size - 1] = border;
+        }
+    }
+
+    void finish() {
+        free(taps);
+        free(map);
+        taps = nullptr;
+        map = nullptr;
+        pixels = owned;
+    }
+
+    // grid x grid tiles of size x size laid out as build() lays them out; they
+    // must outlive the atlas (or the next release())
+    void attach(const uint16_t* tiles, int grid, int size) {
+        release();
+        pixels = tiles;
+        gridSize = grid;
+        tileSize = size;
+    }
+
+    // Contiguous size x size pixels of tile tileNum (1-based); during an
+    // incremental build, valid for the cells already scaled
+    const uint16_t* tile(int tileNum) const {
+        return (owned ? owned : pixels) + (size_t)(tileNum - 1) * tileSize * tileSize;
+    }
+
+    int getTileSize() const { return tileSize; }
+};
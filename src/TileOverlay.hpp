@@ -0,0 +1,101 @@
+#pragma once
+
+#include <Arduino.h>
+#include "PixelKernels.hpp"
+
+// ==============================================================================
+// TileOverlay
+// Translucent touch feedback for a tile: one pre-rendered alpha mask per
+// feedback kind at the board's tile size, blended toward the feedback color
+// over the tile's atlas pixels in a single PixelKernels::blendMask pass. The
+// result is one tileSize x tileSize block, blitted like any tile; clearing the
+// flash is the plain atlas blit again.
+//
+// Masks and the compose buffer live in PSRAM (3 x 16.9 KB + 33.8 KB at 130 px)
+// and are rebuilt only when the tile size changes.
+// ==============================================================================
+
+enum OverlayKind {
+    OVERLAY_VALID,          // Tapped tile that moves: white glow
+    OVERLAY_INVALID,        // Tile that cannot move: red wash
+    OVERLAY_HINT,           // Suggested move: gold glow
+    OVERLAY_KINDS
+};
+
+class TileOverlay {
+private:
+    uint8_t* masks = nullptr;       // OVERLAY_KINDS x size x size
+    uint16_t* composed = nullptr;   // size x size
+    int tileSize = 0;
+    uint32_t lastComposeUs = 0;
+
+    // Alpha (0..255) of kind at distance d from the nearest edge; corner is
+    // the distance along the diagonal from the nearest corner (x + y)
+    static uint8_t alphaAt(OverlayKind kind, int d, int corner) {
+        switch (kind) {
+            case OVERLAY_VALID:
+                if (d < 3) return 230;
+                return (uint8_t)max(56, 200 - (d - 3) * 24);       // Glow fading to a light tint
+            case OVERLAY_INVALID:
+                if (d < 2 || corner < 12) return 220;               // Edge and corner wedges
+                return 110;                                         // Red wash over the tile
+            case OVERLAY_HINT:
+            default:
+                if (d < 3) return 240;
+                return (uint8_t)max(32, 180 - (d - 3) * 20);
+        }
+    }
+
+public:
+    ~TileOverlay() { release(); }
+
+    void release() {
+        if (masks) free(masks);
+        if (composed) free(composed);
+        masks = nullptr;
+        composed = nullptr;
+        tileSize = 0;
+    }
+
+    bool isReady(int size) const { return masks && tileSize == size; }
+
+    bool build(int size) {
+        if (isReady(size)) return true;
+        release();
+        size_t area = (size_t)size * size;
+        masks = (uint8_t*)ps_malloc(area * OVERLAY_KINDS);
+        composed = (uint16_t*)ps_malloc(area * sizeof(uint16_t));
+        if (!masks || !composed) {
+            Serial.println("TileOverlay: no PSRAM for masks, drawing outlines");
+            release();
+            return false;
+        }
+        tileSize = size;
+
+        for (int k = 0; k < OVERLAY_KINDS; k++) {
+            uint8_t* m = masks + k * area;
+            for (int y = 0; y < size; y++) {
+                for (int x = 0; x < size; x++) {
+                    int rx = size - 1 - x, ry = size - 1 - y;
+                    int d = min(min(x, rx), min(y, ry));
+                    int corner = min(min(x + y, rx + y), min(x + ry, rx + ry));
+                    m[y * size + x] = alphaAt((OverlayKind)k, d, corner);
+                }
+            }
+        }
+        Serial.printf("TileOverlay: %d masks of %dx%d\n", OVERLAY_KINDS, size, size);
+        return true;
+    }
+
+    // tile (size x size, as in the TileAtlas) blended toward color (plain
+    // RGB565) through kind's mask; valid until the next compose()
+    const uint16_t* compose(OverlayKind kind, const uint16_t* tile, uint16_t color) {
+        unsigned long t0 = micros();
+        size_t area = (size_t)tileSize * tileSize;
+        PixelKernels::blendMask(composed, tile, masks + kind * area, color, (int)area);
+        lastComposeUs = (uint32_t)(micros() - t0);
+        return composed;
+    }
+
+    uint32_t getLastComposeUs() const { return lastComposeUs; }
+};
@@ -0,0 +1,387 @@
+#pragma once
+
+#include <Arduino.h>
+#include <string.h>
+#include "RenderTarget.hpp"
+#include "Blitter.hpp"
+#include "PixelKernels.hpp"
+
+// ==============================================================================
+// Widgets
+// A small retained UI layer: each screen is a Scene that owns its widgets'
+// geometry, so the same objects draw the screen and hit-test touches. A
+// widget whose state changes (label text, pressed highlight, button caption)
+// marks itself dirty and Scene::draw() repaints only those widgets, reporting
+// the rectangles it touched (for Compositor damage). A transition between two
+// scenes on the same background erases only the old scene's widgets instead of
+// filling the whole screen.
+//
+// Text uses the built-in 6x8 font, so a label's box follows from its text.
+// ==============================================================================
+
+struct WidgetRect {
+    int x, y, w, h;
+
+    bool contains(int tx, int ty) const { return tx >= x && tx < x + w && ty >= y && ty < y + h; }
+    bool isEmpty() const { return w <= 0 || h <= 0; }
+    int32_t area() const { return isEmpty() ? 0 : (int32_t)w * h; }
+
+    WidgetRect unite(const WidgetRect& o) const {
+        if (isEmpty()) return o;
+        if (o.isEmpty()) return *this;
+        int x0 = min(x, o.x), y0 = min(y, o.y);
+        return {x0, y0, max(x + w, o.x + o.w) - x0, max(y + h, o.y + o.h) - y0};
+    }
+};
+
+class Widget {
+public:
+    static const int MAX_TEXT = 48;
+
+protected:
+    WidgetRect box;
+    bool visible = true;
+    bool dirty = true;
+
+    // Bounded copy; longer text is cut at MAX_TEXT - 1 characters
+    static void copyText(char* dst, const char* src) {
+        int n = 0;
+        for (; n < MAX_TEXT - 1 && src[n]; n++) dst[n] = src[n];
+        dst[n] = '\0';
+    }
+
+public:
+    explicit Widget(WidgetRect r) : box(r) {}
+    virtual ~Widget() {}
+
+    const WidgetRect& bounds() const { return box; }
+    bool isVisible() const { return visible; }
+    bool isDirty() const { return dirty; }
+    void invalidate() { dirty = true; }
+
+    void setVisible(bool v) {
+        if (v != visible) { visible = v; dirty = true; }
+    }
+
+    virtual bool isInteractive() const { return false; }
+
+    // Area the next draw() covers (a label may also clear its old extent)
+    virtual WidgetRect paintRect() const { return box; }
+
+    // Paint; background is the scene's (for clearing behind text)
+    virtual void draw(RenderTarget& gfx, Blitter& painter, uint16_t background) = 0;
+
+    // The area under it was cleared (scene repaint or transition)
+    virtual void forgetDrawn() {}
+
+    void markClean() { dirty = false; }
+};
+
+// ==============================================================================
+// Label: one line of text anchored at a point; the box follows the text
+// ==============================================================================
+class Label : public Widget {
+private:
+    int anchorX, anchorY;
+    TextAlign align;
+    int textSize;
+    uint16_t color;
+    char text[MAX_TEXT];
+    WidgetRect drawnBox = {0, 0, 0, 0};     // Extent on screen, cleared on redraw
+
+    WidgetRect textBox() const {
+        int tw = (int)strlen(text) * 6 * textSize, th = 8 * textSize;
+        switch (align) {
+            case TEXT_MIDDLE_LEFT:   return {anchorX, anchorY - th / 2, tw, th};
+            case TEXT_MIDDLE_CENTER: return {anchorX - tw / 2, anchorY - th / 2, tw, th};
+            case TEXT_MIDDLE_RIGHT:  return {anchorX - tw, anchorY - th / 2, tw, th};
+            case TEXT_TOP_LEFT:
+            default:                 return {anchorX, anchorY, tw, th};
+        }
+    }
+
+public:
+    Label(int x, int y, TextAlign a, int size, uint16_t c, const char* t = "")
+        : Widget({0, 0, 0, 0}), anchorX(x), anchorY(y), align(a), textSize(size), color(c) {
+        text[0] = '\0';
+        setText(t);
+    }
+
+    void setText(const char* t) {
+        if (strncmp(t, text, MAX_TEXT - 1) == 0 && box.w) return;
+        copyText(text, t);
+        box = textBox();
+        dirty = true;
+    }
+
+    void setColor(uint16_t c) {
+        if (c != color) { color = c; dirty = true; }
+    }
+
+    const char* getText() const { return text; }
+
+    WidgetRect paintRect() const override { return drawnBox.unite(box); }
+
+    void draw(RenderTarget& gfx, Blitter& painter, uint16_t background) override {
+        if (!drawnBox.isEmpty()) painter.fill(drawnBox.x, drawnBox.y, drawnBox.w, drawnBox.h, background);
+        gfx.setTextColor(color);
+        gfx.setTextAlign(align);
+        gfx.setTextSize(textSize);
+        gfx.drawString(text, anchorX, anchorY);
+        drawnBox = box;
+    }
+
+    void forgetDrawn() override { drawnBox = {0, 0, 0, 0}; }
+};
+
+// ==============================================================================
+// Button: rounded rectangle with a centered caption and a pressed state
+// ==============================================================================
+class Button : public Widget {
+public:
+    static const uint16_t BORDER = 0xFFFF;
+    static const uint16_t PRESSED_BORDER = 0xFEA0;  // Gold
+
+private:
+    uint16_t color;
+    uint16_t textColor;
+    int textSize;
+    bool pressed = false;
+    char caption[MAX_TEXT];
+
+    // Half way to white, per channel
+    static uint16_t lighten(uint16_t c) {
+        uint16_t s = PixelKernels::swap16(c), out;
+        PixelKernels::Reference::blendColor(&out, &s, 0xFFFF, 128, 1);
+        return PixelKernels::swap16(out);
+    }
+
+public:
+    Button(WidgetRect r, uint16_t c, const char* t, uint16_t tc, int size)
+        : Widget(r), color(c), textColor(tc), textSize(size) {
+        copyText(caption, t);
+    }
+
+    bool isInteractive() const override { return true; }
+
+    void setCaption(const char* t) {
+        if (strncmp(t, caption, MAX_TEXT - 1) == 0) return;
+        copyText(caption, t);
+        dirty = true;
+    }
+
+    void setColor(uint16_t c) {
+        if (c != color) { color = c; dirty = true; }
+    }
+
+    void setPressed(bool p) {
+        if (p != pressed) { pressed = p; dirty = true; }
+    }
+
+    bool isPressed() const { return pressed; }
+
+    void draw(RenderTarget& gfx, Blitter&, uint16_t) override {
+        gfx.fillRoundRect(box.x, box.y, box.w, box.h, 8, pressed ? lighten(color) : color);
+        gfx.drawRoundRect(box.x, box.y, box.w, box.h, 8, pressed ? PRESSED_BORDER : BORDER);
+        if (pressed) gfx.drawRoundRect(box.x + 1, box.y + 1, box.w - 2, box.h - 2, 7, PRESSED_BORDER);
+        gfx.setTextColor(textColor);
+        gfx.setTextAlign(TEXT_MIDDLE_CENTER);
+        gfx.setTextSize(textSize);
+        gfx.drawString(caption, box.x + box.w / 2, box.y + box.h / 2);
+    }
+};
+
+// ==============================================================================
+// ImageView: a 480x480 image shown nearest-scaled in a square, with a frame
+// ==============================================================================
+class ImageView : public Widget {
+private:
+    const uint16_t* image = nullptr;
+    int imageSize;
+    int size;
+    int frame;                  // Frame thickness outside the image
+    uint16_t frameColor;
+
+public:
+    ImageView(int x, int y, int s, int frameWidth, uint16_t fc, int srcSize = 480)
+        : Widget({x - frameWidth, y - frameWidth, s + 2 * frameWidth, s + 2 * frameWidth}),
+          imageSize(srcSize), size(s), frame(frameWidth), frameColor(fc) {}
+
+    void setImage(const uint16_t* img, int srcSize = 480) {
+        if (img != image || srcSize != imageSize) { image = img; imageSize = srcSize; dirty = true; }
+        setVisible(img != nullptr);
+    }
+
+    void draw(RenderTarget& gfx, Blitter& painter, uint16_t) override {
+        if (!image) return;
+        int px = box.x + frame, py = box.y + frame;
+        uint16_t* lineBuffer = (uint16_t*)malloc(size * sizeof(uint16_t));
+        uint16_t* map = (uint16_t*)malloc(size * sizeof(uint16_t));
+        if (lineBuffer && map) {
+            PixelKernels::buildScaleMap(map, imageSize, size);
+            Blitter::Frame f(painter);
+            for (int dy = 0; dy < size; dy++) {
+                PixelKernels::scaleRow(lineBuffer, image + map[dy] * imageSize, map, size);
+                painter.blit(px, py + dy, size, 1, lineBuffer);
+            }
+        }
+        free(lineBuffer);
+        free(map);
+        for (int i = 1; i <= frame; i++) {
+            gfx.drawRect(px - i, py - i, size + 2 * i, size + 2 * i, frameColor);
+        }
+    }
+};
+
+// ==============================================================================
+// GridView: rows x cols of equal cells; layout and hit-testing only (the
+// cells' content is drawn by its owner, e.g. the puzzle board)
+// ==============================================================================
+class GridView : public Widget {
+private:
+    int cols, rows;
+    int cellW, cellH;
+
+public:
+    GridView() : Widget({0, 0, 0, 0}), cols(1), rows(1), cellW(0), cellH(0) {}
+
+    void setLayout(int x, int y, int c, int r, int cw, int ch) {
+        box = {x, y, c * cw, r * ch};
+        cols = c; rows = r; cellW = cw; cellH = ch;
+    }
+
+    bool isInteractive() const override { return true; }
+
+    // Cell index (row-major) under the point, or -1
+    int cellAt(int tx, int ty) const {
+        if (!box.contains(tx, ty) || cellW <= 0 || cellH <= 0) return -1;
+        return ((ty - box.y) / cellH) * cols + (tx - box.x) / cellW;
+    }
+
+    WidgetRect cellRect(int index) const {
+        return {box.x + (index % cols) * cellW, box.y + (index / cols) * cellH, cellW, cellH};
+    }
+
+    void draw(RenderTarget&, Blitter&, uint16_t) override {}
+};
+
+// ==============================================================================
+// Scene: a background rectangle and the widgets on it, in paint order
+// ==============================================================================
+class Scene {
+public:
+    static const int MAX_WIDGETS = 16;
+
+private:
+    WidgetRect area;
+    uint16_t background;
+    Widget* widgets[MAX_WIDGETS];
+    int count = 0;
+    WidgetRect drawn[MAX_WIDGETS];
+    int drawnCount = 0;
+    uint32_t lastPixels = 0;
+
+    void paint(Widget& w, RenderTarget& gfx, Blitter& painter) {
+        WidgetRect r = w.paintRect();
+        w.draw(gfx, painter, background);
+        w.markClean();
+        if (drawnCount < MAX_WIDGETS) drawn[drawnCount++] = r;
+        lastPixels += (uint32_t)r.area();
+    }
+
+public:
+    Scene(WidgetRect r, uint16_t bg) : area(r), background(bg) {}
+    virtual ~Scene() {}
+
+    // Widgets are held by pointer: scenes stay where they were built
+    Scene(const Scene&) = delete;
+    Scene& operator=(const Scene&) = delete;
+
+    void add(Widget& w) {
+        if (count < MAX_WIDGETS) widgets[count++] = &w;
+    }
+
+    const WidgetRect& bounds() const { return area; }
+    uint16_t getBackground() const { return background; }
+
+    // Background and every visible widget
+    void drawAll(RenderTarget& gfx, Blitter& painter) {
+        drawnCount = 0;
+        lastPixels = (uint32_t)area.area();
+        Blitter::Frame frame(painter);
+        painter.fill(area.x, area.y, area.w, area.h, background);
+        for (int i = 0; i < count; i++) {
+            Widget& w = *widgets[i];
+            w.forgetDrawn();
+            if (w.isVisible()) w.draw(gfx, painter, background);
+            w.markClean();
+        }
+        drawn[drawnCount++] = area;
+    }
+
+    // Replace previous on screen: on the same background only its widgets are
+    // erased, otherwise the whole area is repainted
+    void show(RenderTarget& gfx, Blitter& painter, Scene* previous) {
+        if (!previous || previous == this || previous->background != background ||
+            previous->area.x != area.x || previous->area.y != area.y ||
+            previous->area.w != area.w || previous->area.h != area.h) {
+            drawAll(gfx, painter);
+            return;
+        }
+        drawnCount = 0;
+        lastPixels = 0;
+        Blitter::Frame frame(painter);
+        for (int i = 0; i < previous->count; i++) {
+            Widget& w = *previous->widgets[i];
+            if (!w.isVisible()) continue;
+            WidgetRect r = w.paintRect();
+            painter.fill(r.x, r.y, r.w, r.h, background);
+            lastPixels += (uint32_t)r.area();
+            w.forgetDrawn();
+            w.invalidate();
+        }
+        for (int i = 0; i < count; i++) {
+            Widget& w = *widgets[i];
+            w.forgetDrawn();
+            if (w.isVisible()) paint(w, gfx, painter);
+            else w.markClean();
+        }
+    }
+
+    // Repaint only the dirty widgets; returns how many
+    int draw(RenderTarget& gfx, Blitter& painter) {
+        drawnCount = 0;
+        lastPixels = 0;
+        Blitter::Frame frame(painter);
+        for (int i = 0; i < count; i++) {
+            Widget& w = *widgets[i];
+            if (!w.isDirty()) continue;
+            if (w.isVisible()) {
+                paint(w, gfx, painter);
+            } else {
+                // Hidden since the last draw: clear where it was
+                WidgetRect r = w.paintRect();
+                painter.fill(r.x, r.y, r.w, r.h, background);
+                w.forgetDrawn();
+                w.markClean();
+                if (drawnCount < MAX_WIDGETS) drawn[drawnCount++] = r;
+                lastPixels += (uint32_t)r.area();
+            }
+        }
+        return drawnCount;
+    }
+
+    // Topmost visible interactive widget under the point
+    Widget* hitTest(int tx, int ty) const {
+        for (int i = count - 1; i >= 0; i--) {
+            Widget* w = widgets[i];
+            if (w->isVisible() && w->isInteractive() && w->bounds().contains(tx, ty)) return w;
+        }
+        return nullptr;
+    }
+
+    // Rectangles the last draw/show/drawAll painted
+    int getDrawnCount() const { return drawnCount; }
+    const WidgetRect& getDrawn(int i) const { return drawn[i]; }
+    uint32_t getLastPixels() const { return lastPixels; }
+};
@@ -3,7 +3,20 @@
 #include "DisplayConfig.hpp"
 #include "LGFX_Setup.hpp"
 #include "PuzzleManager.hpp"
+#include "PuzzleAsset.hpp"
+#include "AssetBlob.hpp"
 #include "SlidingPuzzle.hpp"
+#include "HintEngine.hpp"
+#include "ScrambleGenerator.hpp"
+#include "TileAtlas.hpp"
+#include "ImageCache.hpp"
+#include "TileOverlay.hpp"
+#include "Blitter.hpp"
+#include "Compositor.hpp"
+#include "Animation.hpp"
+#include "LGFXTarget.hpp"
+#include "GameScreens.hpp"
+#include "StatusBar.hpp"
 
 // ==============================================================================
 // Sound Configuration (Optional)
@@ -24,15 +37,47 @@
 enum GameState { MAIN_MENU, PUZZLE_SELECT, PLAYING, WIN_SCREEN };
 
 LGFX tft;
+LGFXTarget screen(&tft);        // What the screens draw on (src/GameScreens.hpp)
+LGFXSpriteTarget backBuffer(&tft);
+Blitter blitter(screen);        // Batched, counted tile/fill writes to the panel
+Compositor compositor(screen, blitter);   // Game screen back buffer + dirty rects
+StatusBar statusBar;            // Glyph-cell updates of moves/time
+MainMenuScene menuScene;        // Retained screens: they draw and hit-test
+PuzzleSelectScene selectScene;
+WinScene winScene;
+GameScene gameScene;            // Game button bar + board hit-testing
+Scene* shownScene = nullptr;    // Scene on the panel (nullptr: something else)
 PuzzleManager puzzleManager;
 SlidingPuzzle* puzzle = nullptr;
+HintTable3x3 hintTable3;
+PatternDatabase4x4 patternDb4;
+HintEngine hintEngine;
+ScrambleGenerator scrambleGenerator(hintEngine);
+uint32_t pendingSeed = 0;    // Board prepared on the win screen for Play Again
 
 GameState gameState = MAIN_MENU;
 int selectedDifficulty = 0;
 int selectedPuzzle = 0;
 
-// Image buffer in PSRAM (480x480 RGB565 = 460800 bytes)
-uint16_t* puzzleImageBuffer = nullptr;
+// Puzzle in play: its 480x480 image and tiles pre-scaled to the board's tile
+// size, from the image cache (PSRAM) or the asset blob (mapped flash)
+const uint16_t* puzzleImage = nullptr;     // nullptr with the blob
+const TileAtlas* boardAtlas = nullptr;
+ImageCache imageCache(LittleFS, ATLAS_BOX, COL_GRID_LINE);
+AssetBlob assetBlob;            // Pre-scaled tiles + previews in mapped flash
+AssetBlob::View blobView = {};  // Current puzzle in the blob (tiles nullptr: none)
+TileAtlas blobAtlas;            // Attached to blobView.tiles
+
+// Streaming start: board cells still waiting for their tile's pixels, and
+// the start's milestones (us since startGame())
+uint32_t pendingCells = 0;
+unsigned long loadStartUs = 0;
+unsigned long firstTileUs = 0;
+
+// Prefetch on the puzzle select screen: its first puzzles, a slice per loop pass
+const int PREFETCH_PUZZLES = 2;
+const uint32_t PREFETCH_SLICE_US = 4000;
+TileOverlay tileOverlay;        // Touch feedback masks at the board's tile size
 
 // Timer tracking
 unsigned long gameStartTime = 0;
@@ -46,32 +91,56 @@ bool lastTouchState = false;
 unsigned long lastTouchTime = 0;
 const unsigned long TOUCH_DEBOUNCE_MS = 250;
 
+// Pressed highlight on a game bar button, released after a moment
+Button* pressedButton = nullptr;
+unsigned long pressedTime = 0;
+const unsigned long BUTTON_PRESS_MS = 150;
+
 // Animation state
+// A slide moves a run of 1..gridSize-1 tiles one cell toward the empty slot
+const int MAX_LINE = 4;
 bool isAnimating = false;
-unsigned long animStartTime = 0;
-int animFromPos = -1;
-int animToPos = -1;
-int animTileNum = 0;
+int animFromPos = -1;           // Empty slot before the move (a tile after it)
+int animToPos = -1;             // Tapped tile (the empty slot after the move)
+int animCount = 0;
+int animTiles[MAX_LINE];        // Tile numbers, nearest the empty slot first
+int animTileDX[MAX_LINE];       // Each tile's offset in the moving block
+int animTileDY[MAX_LINE];
+int animBlockW = 0;             // Size of the moving block
+int animBlockH = 0;
 const unsigned long ANIM_DURATION_MS = 180;
+const int ANIM_FPS = 60;
+FramePacer animPacer(ANIM_FPS);
+SlideAnimation slide;
+int animPrevX = 0;              // Where the moving tile was last drawn
+int animPrevY = 0;
 
 // Touch feedback state
 int flashTile = -1;
 unsigned long flashStartTime = 0;
-uint16_t flashColor = 0;
+OverlayKind flashKind = OVERLAY_VALID;
+unsigned long flashDuration = 0;
 const unsigned long FLASH_DURATION_MS = 100;
+const unsigned long HINT_FLASH_MS = 600;
+
+// Hint search budget: answer within one frame, never stall loop()
+const SolveBudget HINT_BUDGET = {15, 0};
 
-// UI Constants
-const int STATUS_BAR_HEIGHT = 40;
-const int BUTTON_BAR_HEIGHT = 50;
-const int GAME_AREA_Y = STATUS_BAR_HEIGHT;
-const int GAME_AREA_SIZE = 480 - STATUS_BAR_HEIGHT - BUTTON_BAR_HEIGHT;
-// Grid draws within GAME_AREA_Y to GAME_AREA_Y + GAME_AREA_SIZE
+// Auto-solve demo state (plays a HintEngine plan one move per step)
+MoveDir demoPlan[HintEngine::MAX_PLAN];
+int demoLength = 0;
+int demoIndex = 0;
+bool demoActive = false;
+bool demoUsed = false;          // Win screen says "solved by demo"
+unsigned long lastDemoStep = 0;
+const unsigned long DEMO_STEP_MS = 120;
 
 // Forward declarations
 void showMainMenu();
-void showPuzzleSelect(int difficulty);
+void showPuzzleSelect(int difficulty, int page = 0);
 void showWinScreen();
 void startGame(int difficulty, int puzzleIndex);
+void releasePuzzleImage();
 
 #ifdef ENABLE_SOUND
 void initSound();
@@ -81,23 +150,6 @@ void playErrorSound();
 void playWinSound();
 #endif
 
-// Colors
-const uint16_t COL_BG        = 0x1082;  // Dark gray
-const uint16_t COL_MENU_BG   = 0x000F;  // Dark blue
-const uint16_t COL_BTN       = 0x2945;  // Button gray
-const uint16_t COL_BTN_EASY  = 0x07E0;  // Green
-const uint16_t COL_BTN_MED   = 0xFFE0;  // Yellow
-const uint16_t COL_BTN_HARD  = 0xF800;  // Red
-const uint16_t COL_BTN_SEL   = 0x04FF;  // Cyan
-const uint16_t COL_WHITE     = 0xFFFF;
-const uint16_t COL_BLACK     = 0x0000;
-const uint16_t COL_GRID_LINE = 0x4208;  // Grid separator
-const uint16_t COL_EMPTY     = 0x2104;  // Empty tile
-const uint16_t COL_WIN_BG    = 0x0320;  // Dark green
-const uint16_t COL_GOLD      = 0xFEA0;  // Gold
-const uint16_t COL_FLASH_VALID   = 0xFFFF;  // White highlight for valid tile
-const uint16_t COL_FLASH_INVALID = 0xF800;  // Red flash for invalid tile
-
 // ==============================================================================
 // Sound Functions (Optional PWM Buzzer Support)
 // ==============================================================================
@@ -227,70 +279,49 @@ void run_init_sequence() {
 }
 
 // ==============================================================================
-// Helper: Draw a rounded-corner button
-// ==============================================================================
-void drawButton(int x, int y, int w, int h, uint16_t color, const char* label, uint16_t textColor = COL_WHITE) {
-    tft.fillRoundRect(x, y, w, h, 8, color);
-    tft.drawRoundRect(x, y, w, h, 8, COL_WHITE);
-    tft.setTextColor(textColor);
-    tft.setTextDatum(textdatum_t::middle_center);
-    tft.drawString(label, x + w / 2, y + h / 2);
-}
-
-// ==============================================================================
-// Helper: Check if point is inside rectangle
+// Puzzle image and tiles for info: mapped from the asset blob, or from the
+// image cache (which loads from LittleFS on a miss, handing each tile to
+// onCell as soon as it is scaled)
 // ==============================================================================
-bool inRect(int tx, int ty, int rx, int ry, int rw, int rh) {
-    return tx >= rx && tx < rx + rw && ty >= ry && ty < ry + rh;
-}
-
-// ==============================================================================
-// Load puzzle image into PSRAM buffer
-// ==============================================================================
-bool loadPuzzleImage(const String& filename) {
-    if (puzzleImageBuffer) {
-        free(puzzleImageBuffer);
-        puzzleImageBuffer = nullptr;
-    }
-
-    puzzleImageBuffer = (uint16_t*)ps_malloc(480 * 480 * sizeof(uint16_t));
-    if (!puzzleImageBuffer) {
-        Serial.println("ERROR: Failed to allocate PSRAM for image!");
-        return false;
-    }
-
-    File file = LittleFS.open(filename, "r");
-    if (!file) {
-        Serial.printf("ERROR: Failed to open %s\n", filename.c_str());
-        free(puzzleImageBuffer);
-        puzzleImageBuffer = nullptr;
-        return false;
-    }
-
-    size_t fileSize = file.size();
-    if (fileSize != 460800) {
-        Serial.printf("ERROR: Invalid file size %d\n", fileSize);
-        file.close();
-        free(puzzleImageBuffer);
-        puzzleImageBuffer = nullptr;
-        return false;
+bool loadPuzzleImage(const PuzzleInfo& info, ImageCache::CellCallback onCell = nullptr) {
+    int gridSize = info.gridSize;
+    int tileSize = GAME_AREA_SIZE / gridSize;
+    releasePuzzleImage();
+
+    // Asset blob: the tiles are already scaled in flash, map them and go
+    if (assetBlob.isReady()) {
+        AssetBlob::View v;
+        if (assetBlob.map(info.index, v) && v.gridSize == gridSize && v.tileSize == tileSize) {
+            blobView = v;
+            blobAtlas.attach(v.tiles, gridSize, tileSize);
+            boardAtlas = &blobAtlas;
+            tileOverlay.build(tileSize);
+            return true;
+        }
+        Serial.printf("AssetBlob: no %dx%d entry for %s, loading the file\n", gridSize, gridSize, info.filename);
     }
 
-    // Read entire image into buffer
-    size_t bytesRead = file.read((uint8_t*)puzzleImageBuffer, 460800);
-    file.close();
-
-    if (bytesRead != 460800) {
-        Serial.printf("ERROR: Only read %d bytes\n", bytesRead);
-        free(puzzleImageBuffer);
-        puzzleImageBuffer = nullptr;
+    // Decoded images stay cached in PSRAM: a recent puzzle skips flash
+    const ImageCache::Slot* slot = imageCache.acquire(info, tileSize, onCell);
+    if (!slot) {
+        Serial.printf("ERROR: Failed to load %s\n", info.filename);
         return false;
     }
-
-    Serial.println("Puzzle image loaded into PSRAM");
+    puzzleImage = slot->image;
+    boardAtlas = &slot->atlas;
+    tileOverlay.build(tileSize);
     return true;
 }
 
+// Done with the puzzle in play (it stays in the cache)
+void releasePuzzleImage() {
+    puzzleImage = nullptr;
+    boardAtlas = nullptr;
+    blobAtlas.release();
+    blobView = {};
+    imageCache.unpin();
+}
+
 // ==============================================================================
 // Get elapsed game time in seconds
 // ==============================================================================
@@ -301,14 +332,39 @@ unsigned long getGameSeconds() {
 }
 
 // ==============================================================================
-// Format time as MM:SS
+// Fresh scramble seed (Arduino random() is backed by the hardware RNG)
+// ==============================================================================
+uint32_t newScrambleSeed() {
+    return (uint32_t)random(1, 0x7FFFFFFF);
+}
+
+// ==============================================================================
+// Scramble to the difficulty's optimal-length range (cached per seed)
 // ==============================================================================
-String formatTime(unsigned long seconds) {
-    int mins = seconds / 60;
-    int secs = seconds % 60;
-    char buf[16];
-    snprintf(buf, sizeof(buf), "%02d:%02d", mins, secs);
-    return String(buf);
+void applyScramble(uint32_t seed) {
+    int optimal = scrambleGenerator.generate(*puzzle, seed);
+    const ScrambleGenerator::Stats& s = scrambleGenerator.getStats();
+    Serial.printf("Scramble seed %u: optimal %d (%u candidates, %u nodes, %u ms, cache %u/%u)%s\n",
+                  seed, optimal, s.candidates, s.nodes, s.elapsedMs,
+                  s.cacheHits, s.cacheHits + s.cacheMisses, s.budgetHit ? ", node budget hit" : "");
+}
+
+// ==============================================================================
+// Put a scene on the panel: after a scene on the same background only the old
+// widgets are erased, otherwise the whole screen is repainted
+// ==============================================================================
+void showScene(Scene& scene) {
+    scene.show(screen, blitter, shownScene);
+    shownScene = &scene;
+    Serial.printf("Scene: %u px in %d rect(s)\n", (unsigned)scene.getLastPixels(), scene.getDrawnCount());
+}
+
+// Pressed highlight on a button of the scene on the panel, before its action
+// (the action replaces the screen, so the button is released unseen)
+void pressButton(Scene& scene, Button& button) {
+    button.setPressed(true);
+    scene.draw(screen, blitter);
+    button.setPressed(false);
 }
 
 // ==============================================================================
@@ -316,99 +372,59 @@ String formatTime(unsigned long seconds) {
 // ==============================================================================
 void showMainMenu() {
     gameState = MAIN_MENU;
-    tft.fillScreen(COL_MENU_BG);
-
-    // Title
-    tft.setTextColor(COL_WHITE);
-    tft.setTextDatum(textdatum_t::middle_center);
-    tft.setTextSize(4);
-    tft.drawString("SLIDING", 240, 100);
-    tft.drawString("PUZZLE", 240, 155);
-
-    tft.setTextSize(2);
-    tft.setTextColor(0xBDF7);
-    tft.drawString("Select Difficulty", 240, 220);
-
-    // Difficulty buttons
-    int btnW = 300, btnH = 60;
-    int btnX = (480 - btnW) / 2;
-
-    tft.setTextSize(3);
-    drawButton(btnX, 260, btnW, btnH, COL_BTN_EASY, "EASY  (3x3)", COL_BLACK);
-    drawButton(btnX, 340, btnW, btnH, COL_BTN_MED,  "MEDIUM (4x4)", COL_BLACK);
-    drawButton(btnX, 420, btnW, btnH, COL_BTN_HARD, "HARD  (5x5)", COL_WHITE);
+    showScene(menuScene);
 }
 
 // ==============================================================================
 // PUZZLE SELECT
 // ==============================================================================
-void showPuzzleSelect(int difficulty) {
+// Decode the likely picks (top of the shown page) while the player reads the
+// list; loop() steps the cache
+void prefetchShownPuzzles() {
+    imageCache.cancelPrefetch();
+    if (assetBlob.isReady()) return;
+    int first = selectScene.page() * PuzzleSelectScene::SLOTS;
+    int count = puzzleManager.getPuzzleCount(selectedDifficulty);
+    for (int i = first; i < first + PREFETCH_PUZZLES && i < count; i++) {
+        PuzzleInfo info = puzzleManager.getPuzzle(selectedDifficulty, i);
+        imageCache.prefetch(info, GAME_AREA_SIZE / info.gridSize);
+    }
+}
+
+void showPuzzleSelect(int difficulty, int page) {
     gameState = PUZZLE_SELECT;
     selectedDifficulty = difficulty;
+    selectScene.set(difficulty, puzzleManager, page);
+    showScene(selectScene);
+    prefetchShownPuzzles();
+}
 
-    tft.fillScreen(COL_MENU_BG);
-
-    const char* diffNames[] = {"Easy (3x3)", "Medium (4x4)", "Hard (5x5)"};
-    const uint16_t diffColors[] = {COL_BTN_EASY, COL_BTN_MED, COL_BTN_HARD};
-
-    // Title
-    tft.setTextColor(diffColors[difficulty]);
-    tft.setTextDatum(textdatum_t::middle_center);
-    tft.setTextSize(3);
-    tft.drawString(diffNames[difficulty], 240, 30);
-
-    tft.setTextSize(2);
-    tft.setTextColor(0xBDF7);
-    tft.drawString("Choose a Puzzle", 240, 65);
-
-    // Show 5 puzzle buttons
-    const auto& puzzles = puzzleManager.getPuzzles(difficulty);
-    int btnW = 420, btnH = 55;
-    int btnX = (480 - btnW) / 2;
-    int startY = 95;
-
-    tft.setTextSize(2);
-    for (int i = 0; i < (int)puzzles.size() && i < 5; i++) {
-        int btnY = startY + i * 65;
-        char label[64];
-        snprintf(label, sizeof(label), "%d. %s", i + 1, puzzles[i].displayName.c_str());
-        drawButton(btnX, btnY, btnW, btnH, COL_BTN, label);
-    }
-
-    // Back button
-    tft.setTextSize(2);
-    drawButton(10, 430, 120, 40, 0x8000, "< Back");
+// ==============================================================================
+// Current game state as the screens see it
+// ==============================================================================
+GameView gameView() {
+    GameView view = {};
+    view.puzzle = puzzle;
+    view.atlas = boardAtlas;
+    view.overlay = &tileOverlay;
+    view.image = puzzleImage;
+    view.layout = BoardLayout::forGrid(puzzle ? puzzle->getGridSize() : 3);
+    view.moves = puzzle ? puzzle->getMoveCount() : 0;
+    view.seconds = getGameSeconds();
+    view.demoActive = demoActive;
+    return view;
 }
 
 // ==============================================================================
 // Draw flash feedback overlay on a tile
 // ==============================================================================
-void drawFlashFeedback(int gridPos, int gridSize, int tileSize, int offsetX, int offsetY, uint16_t color) {
+void drawFlashFeedback(int gridPos, int gridSize, int tileSize, int offsetX, int offsetY, OverlayKind kind) {
     int row = gridPos / gridSize;
     int col = gridPos % gridSize;
     int x = offsetX + col * tileSize;
     int y = offsetY + row * tileSize;
-
-    // Draw a thick border for valid tile (white/yellow)
-    if (color == COL_FLASH_VALID) {
-        // Draw multiple rectangles for thick border
-        for (int i = 0; i < 3; i++) {
-            tft.drawRect(x + i, y + i, tileSize - (i * 2), tileSize - (i * 2), color);
-        }
-    } else {
-        // Draw red semi-transparent overlay for invalid tile
-        // Since we can't do true transparency in RGB565, we'll draw a red border + corners
-        tft.drawRect(x, y, tileSize, tileSize, color);
-        tft.drawRect(x + 1, y + 1, tileSize - 2, tileSize - 2, color);
-
-        // Draw diagonal lines in corners for stronger effect
-        for (int i = 0; i < 10; i++) {
-            tft.drawLine(x + i, y, x, y + i, color);
-            tft.drawLine(x + tileSize - 1 - i, y, x + tileSize - 1, y + i, color);
-            tft.drawLine(x + i, y + tileSize - 1, x, y + tileSize - 1 - i, color);
-            tft.drawLine(x + tileSize - 1 - i, y + tileSize - 1, x + tileSize - 1, y + tileSize - 1 - i, color);
-        }
-    }
+    compositor.damage(x, y, tileSize, tileSize);
+    GameScreens::flash(compositor.gfx(), compositor.painter(), gameView(), kind, puzzle->getTile(gridPos), x, y);
 }
 
 // ==============================================================================
@@ -429,62 +445,8 @@ void drawTile(int tileNum, int gridPos, int gridSize, int tileSize, int offsetX,
         destY = offsetY + destRow * tileSize;
     }
 
-    if (tileNum == 0) {
-        // Empty tile
-        tft.fillRect(destX, destY, tileSize, tileSize, COL_EMPTY);
-        return;
-    }
-
-    if (!puzzleImageBuffer) {
-        // Fallback: numbered tile
-        tft.fillRect(destX, destY, tileSize, tileSize, COL_BTN);
-        tft.drawRect(destX, destY, tileSize, tileSize, COL_WHITE);
-        tft.setTextColor(COL_WHITE);
-        tft.setTextDatum(textdatum_t::middle_center);
-        tft.setTextSize(2);
-        char buf[4];
-        snprintf(buf, sizeof(buf), "%d", tileNum);
-        tft.drawString(buf, destX + tileSize / 2, destY + tileSize / 2);
-        return;
-    }
-
-    // Calculate source region from the original image
-    // Tile N corresponds to position N-1 in the solved puzzle
-    int srcRow = (tileNum - 1) / gridSize;
-    int srcCol = (tileNum - 1) % gridSize;
-
-    // Source coordinates in the 480x480 image
-    // Scale: each tile maps to (480/gridSize) pixels in the source image
-    int imgTileSize = 480 / gridSize;
-    int srcX = srcCol * imgTileSize;
-    int srcY = srcRow * imgTileSize;
-
-    // Draw tile line by line, scaling from image to screen tile size
-    // If tileSize == imgTileSize, it's 1:1. Otherwise we need to scale.
-    if (tileSize == imgTileSize) {
-        // Direct copy, row by row
-        for (int row = 0; row < tileSize; row++) {
-            tft.pushImage(destX, destY + row, tileSize, 1,
-                          &puzzleImageBuffer[(srcY + row) * 480 + srcX]);
-        }
-    } else {
-        // Scale: use nearest-neighbor
-        uint16_t* lineBuffer = (uint16_t*)malloc(tileSize * sizeof(uint16_t));
-        if (lineBuffer) {
-            for (int dy = 0; dy < tileSize; dy++) {
-                int sy = srcY + (dy * imgTileSize) / tileSize;
-                for (int dx = 0; dx < tileSize; dx++) {
-                    int sx = srcX + (dx * imgTileSize) / tileSize;
-                    lineBuffer[dx] = puzzleImageBuffer[sy * 480 + sx];
-                }
-                tft.pushImage(destX, destY + dy, tileSize, 1, lineBuffer);
-            }
-            free(lineBuffer);
-        }
-    }
-
-    // Draw thin grid border on tile
-    tft.drawRect(destX, destY, tileSize, tileSize, COL_GRID_LINE);
+    compositor.damage(destX, destY, tileSize, tileSize);
+    GameScreens::tile(compositor.gfx(), compositor.painter(), gameView(), tileNum, destX, destY);
 }
 
 // ==============================================================================
@@ -499,30 +461,52 @@ void drawStatusBar() {
     lastDisplayedSeconds = (int)secs;
     lastDisplayedMoves = moves;
 
-    tft.fillRect(0, 0, 480, STATUS_BAR_HEIGHT, COL_BLACK);
-    tft.setTextColor(COL_WHITE);
-    tft.setTextDatum(textdatum_t::middle_left);
-    tft.setTextSize(2);
-
-    char buf[32];
-    snprintf(buf, sizeof(buf), "Moves: %d", moves);
-    tft.drawString(buf, 10, STATUS_BAR_HEIGHT / 2);
+    // Only the characters that changed, when the bar on screen is known
+    if (statusBar.update(compositor.painter(), moves, secs)) {
+        for (int i = 0; i < statusBar.getDirtyCount(); i++) {
+            const StatusBar::Rect& r = statusBar.getDirty(i);
+            compositor.damage(r.x, r.y, r.w, r.h);
+        }
+        return;
+    }
 
-    String timeStr = "Time: " + formatTime(secs);
-    tft.setTextDatum(textdatum_t::middle_right);
-    tft.drawString(timeStr.c_str(), 470, STATUS_BAR_HEIGHT / 2);
+    compositor.damage(0, 0, 480, STATUS_BAR_HEIGHT);
+    GameScreens::statusBar(compositor.gfx(), moves, secs);
+    statusBar.shown(moves, secs);
 }
 
 // ==============================================================================
-// Draw button bar (Restart / Back)
+// Draw button bar (Back / Hint / Solve / Restart)
 // ==============================================================================
 void drawButtonBar() {
-    int barY = 480 - BUTTON_BAR_HEIGHT;
-    tft.fillRect(0, barY, 480, BUTTON_BAR_HEIGHT, COL_BLACK);
+    // Only the buttons whose caption or pressed state changed
+    gameScene.setDemoActive(demoActive);
+    gameScene.draw(compositor.gfx(), compositor.painter());
+    for (int i = 0; i < gameScene.getDrawnCount(); i++) {
+        const WidgetRect& r = gameScene.getDrawn(i);
+        compositor.damage(r.x, r.y, r.w, r.h);
+    }
+}
+
+// Pressed highlight on a bar button until BUTTON_PRESS_MS has passed
+void pressBarButton(Button& button) {
+    if (pressedButton && pressedButton != &button) pressedButton->setPressed(false);
+    button.setPressed(true);
+    pressedButton = &button;
+    pressedTime = millis();
+    drawButtonBar();
+}
 
-    tft.setTextSize(2);
-    drawButton(10, barY + 5, 140, 40, 0x8000, "< Back");
-    drawButton(330, barY + 5, 140, 40, COL_BTN_MED, "Restart", COL_BLACK);
+// ==============================================================================
+// Cells the moving block lands on (animFromPos up to, not including, animToPos)
+// ==============================================================================
+bool isAnimatedCell(int pos) {
+    if (!isAnimating || animCount == 0) return false;
+    int step = (animToPos - animFromPos) / animCount;
+    for (int i = 0; i < animCount; i++) {
+        if (pos == animFromPos + i * step) return true;
+    }
+    return false;
 }
 
 // ==============================================================================
@@ -531,32 +515,30 @@ void drawButtonBar() {
 void drawGameScreen(bool skipAnimatingTile = false) {
     if (!puzzle) return;
 
-    int gridSize = puzzle->getGridSize();
-    int tileSize = GAME_AREA_SIZE / gridSize;
-    int offsetX = (480 - tileSize * gridSize) / 2;
-    int offsetY = GAME_AREA_Y + (GAME_AREA_SIZE - tileSize * gridSize) / 2;
-
-    // Clear game area
-    tft.fillRect(0, GAME_AREA_Y, 480, GAME_AREA_SIZE, COL_BG);
-
-    // Draw all tiles
-    int totalTiles = gridSize * gridSize;
+    GameView view = gameView();
+    int totalTiles = view.layout.gridSize * view.layout.gridSize;
     for (int pos = 0; pos < totalTiles; pos++) {
-        // Skip the animating tile if requested
-        if (skipAnimatingTile && isAnimating && pos == animToPos) {
-            continue;
-        }
-
-        int tileNum = puzzle->getTile(pos);
-        drawTile(tileNum, pos, gridSize, tileSize, offsetX, offsetY);
+        // Skip the animating tiles if requested
+        if (skipAnimatingTile && isAnimatedCell(pos)) view.skipCells |= 1u << pos;
     }
-
-    drawStatusBar();
-    drawButtonBar();
+    view.skipCells |= pendingCells;     // Tiles not loaded yet: board background
+
+    // One transaction for the whole redraw
+    Blitter& painter = compositor.painter();
+    painter.begin();
+    compositor.damageAll();
+    GameScreens::game(compositor.gfx(), painter, view, gameScene);
+    statusBar.shown(view.moves, view.seconds);
+    lastDisplayedSeconds = (int)view.seconds;
+    lastDisplayedMoves = view.moves;
+    painter.end();
+
+    compositor.flush();
+    compositor.printLastFrame("Game screen");
 }
 
 // ==============================================================================
-// Redraw only the two tiles that changed (+ status bar)
+// Redraw only the tiles that changed: the line from pos1 to pos2 (+ status bar)
 // ==============================================================================
 void redrawMovedTiles(int pos1, int pos2) {
     if (!puzzle) return;
@@ -565,9 +547,14 @@ void redrawMovedTiles(int pos1, int pos2) {
     int tileSize = GAME_AREA_SIZE / gridSize;
     int offsetX = (480 - tileSize * gridSize) / 2;
     int offsetY = GAME_AREA_Y + (GAME_AREA_SIZE - tileSize * gridSize) / 2;
+    int step = (pos1 / gridSize == pos2 / gridSize) ? 1 : gridSize;
+    if (pos2 < pos1) step = -step;
 
-    drawTile(puzzle->getTile(pos1), pos1, gridSize, tileSize, offsetX, offsetY);
-    drawTile(puzzle->getTile(pos2), pos2, gridSize, tileSize, offsetX, offsetY);
+    Blitter::Frame frame(compositor.painter());
+    for (int pos = pos1; ; pos += step) {
+        drawTile(puzzle->getTile(pos), pos, gridSize, tileSize, offsetX, offsetY);
+        if (pos == pos2) break;
+    }
 
     // Force status bar update
     lastDisplayedMoves = -1;
@@ -575,38 +562,81 @@ void redrawMovedTiles(int pos1, int pos2) {
 }
 
 // ==============================================================================
-// START GAME
+// Remove any flash/hint highlight by redrawing its tile
 // ==============================================================================
-void startGame(int difficulty, int puzzleIndex) {
-    gameState = PLAYING;
-    selectedDifficulty = difficulty;
-    selectedPuzzle = puzzleIndex;
+void clearFlashFeedback() {
+    if (flashTile < 0) return;
+    if (puzzle && !isAnimating) {
+        int gridSize = puzzle->getGridSize();
+        int tileSize = GAME_AREA_SIZE / gridSize;
+        int offsetX = (480 - tileSize * gridSize) / 2;
+        int offsetY = GAME_AREA_Y + (GAME_AREA_SIZE - tileSize * gridSize) / 2;
+
+        // Only redraw if the tile is still in the same position (not animating);
+        // with an atlas this is one blit of the cached tile pixels
+        drawTile(puzzle->getTile(flashTile), flashTile, gridSize, tileSize, offsetX, offsetY);
+    }
+    flashTile = -1;
+}
 
-    const PuzzleInfo& info = puzzleManager.getPuzzle(difficulty, puzzleIndex);
-    Serial.printf("Starting game: %s (%dx%d)\n", info.displayName.c_str(), info.gridSize, info.gridSize);
+// ==============================================================================
+// Auto-solve demo: plan once (bounded time), then play a move per step
+// ==============================================================================
+void stopDemo() {
+    if (!demoActive) return;
+    demoActive = false;
+    if (gameState == PLAYING) drawButtonBar();
+}
 
-    // Load image
-    tft.fillScreen(COL_BLACK);
-    tft.setTextColor(COL_WHITE);
-    tft.setTextDatum(textdatum_t::middle_center);
-    tft.setTextSize(2);
-    tft.drawString("Loading...", 240, 240);
+void startDemo() {
+    unsigned long t0 = micros();
+    demoLength = hintEngine.planSolution(*puzzle, demoPlan, HintEngine::MAX_PLAN);
+    Serial.printf("Demo plan: %d moves in %lu us\n", demoLength, micros() - t0);
+    if (demoLength <= 0) return;
 
-    if (!loadPuzzleImage(info.filename)) {
-        tft.fillScreen(0xF800);
-        tft.drawString("Failed to load image!", 240, 240);
-        delay(2000);
-        showMainMenu();
+    demoIndex = 0;
+    demoActive = true;
+    demoUsed = true;
+    lastDemoStep = 0;
+    drawButtonBar();
+}
+
+// ==============================================================================
+// One tile's pixels arrived during a streaming load: draw it where the
+// scramble put it and push it to the panel now (atlas cell N-1 is tile N; the
+// last cell has no tile on the board)
+// ==============================================================================
+void drawArrivedTile(void*, int cell, const TileAtlas& atlas) {
+    int gridSize = puzzle->getGridSize();
+    BoardLayout l = BoardLayout::forGrid(gridSize);
+    for (int pos = 0; pos < gridSize * gridSize; pos++) {
+        if (puzzle->getTile(pos) != cell + 1) continue;
+        {
+            Blitter::Frame frame(compositor.painter());
+            compositor.damage(l.cellX(pos), l.cellY(pos), l.tileSize, l.tileSize);
+            compositor.painter().blit(l.cellX(pos), l.cellY(pos), l.tileSize, l.tileSize, atlas.tile(cell + 1));
+        }
+        compositor.flush();
+        pendingCells &= ~(1u << pos);
+        if (!firstTileUs) firstTileUs = micros() - loadStartUs;
         return;
     }
+}
 
-    // Create puzzle
-    if (puzzle) delete puzzle;
-    puzzle = new SlidingPuzzle(info.gridSize);
+// ==============================================================================
+// START GAME
+// ==============================================================================
+void startGame(int difficulty, int puzzleIndex) {
+    gameState = PLAYING;
+    demoActive = false;
+    demoUsed = false;
+    selectedDifficulty = difficulty;
+    selectedPuzzle = puzzleIndex;
 
-    // Shuffle based on difficulty
-    int shuffleMoves = (info.gridSize == 3) ? 50 : (info.gridSize == 4) ? 150 : 300;
-    puzzle->shuffle(shuffleMoves);
+    PuzzleInfo info = puzzleManager.getPuzzle(difficulty, puzzleIndex);
+    Serial.printf("Starting game: %s (%dx%d)\n", info.displayName, info.gridSize, info.gridSize);
+    loadStartUs = micros();
+    firstTileUs = 0;
 
     // Reset timer state
     gameStartTime = 0;
@@ -615,80 +645,223 @@ void startGame(int difficulty, int puzzleIndex) {
     lastDisplayedSeconds = -1;
     lastDisplayedMoves = -1;
 
+    // Game screen with an empty board first: status, buttons, board background
+    shownScene = nullptr;
+    releasePuzzleImage();
+    if (puzzle) delete puzzle;
+    puzzle = new SlidingPuzzle(info.gridSize);
+    BoardLayout l = BoardLayout::forGrid(info.gridSize);
+    int cells = info.gridSize * info.gridSize;
+    pendingCells = (1u << cells) - 1;
     drawGameScreen();
+    unsigned long screenUs = micros() - loadStartUs;
+
+    // Calibrated scramble; Play Again uses the board prepared on the win screen
+    uint32_t seed = pendingSeed ? pendingSeed : newScrambleSeed();
+    pendingSeed = 0;
+    applyScramble(seed);
+    int emptyPos = puzzle->getEmptyPos();
+    pendingCells &= ~(1u << emptyPos);
+    {
+        Blitter::Frame frame(compositor.painter());
+        drawTile(0, emptyPos, l.gridSize, l.tileSize, l.offsetX, l.offsetY);
+    }
+    compositor.flush();
+
+    // Tiles land one by one as their source rows decode (a cache miss)
+    if (!loadPuzzleImage(info, drawArrivedTile)) {
+        pendingCells = 0;
+        screen.fillScreen(0xF800);
+        screen.setTextColor(COL_WHITE);
+        screen.setTextAlign(TEXT_MIDDLE_CENTER);
+        screen.setTextSize(2);
+        screen.drawString("Failed to load image!", 240, 240);
+        delay(2000);
+        showMainMenu();
+        return;
+    }
+
+    // Whatever did not stream in (a cache hit, the blob): draw it now
+    if (pendingCells) {
+        Blitter::Frame frame(compositor.painter());
+        for (int pos = 0; pos < cells; pos++) {
+            if (!(pendingCells & (1u << pos))) continue;
+            pendingCells &= ~(1u << pos);
+            drawTile(puzzle->getTile(pos), pos, l.gridSize, l.tileSize, l.offsetX, l.offsetY);
+        }
+    }
+    compositor.flush();
+    if (!firstTileUs) firstTileUs = micros() - loadStartUs;
+    Serial.printf("Start: screen %.1f ms, first tile %.1f ms, interactive %.1f ms\n",
+                  screenUs / 1000.0, firstTileUs / 1000.0, (micros() - loadStartUs) / 1000.0);
 
     Serial.println("Game started!");
     puzzle->printBoard();
 }
 
 // ==============================================================================
-// Start tile animation
+// Start the slide of the run from tilePos to the empty slot (before the move):
+// the tiles move together as one block, one cell toward the slot
 // ==============================================================================
-void startTileAnimation(int fromPos, int toPos, int tileNum) {
+void startLineAnimation(int tilePos) {
+    int gridSize = puzzle->getGridSize();
+    int tileSize = GAME_AREA_SIZE / gridSize;
+    int offsetX = (480 - tileSize * gridSize) / 2;
+    int offsetY = GAME_AREA_Y + (GAME_AREA_SIZE - tileSize * gridSize) / 2;
+
+    int emptyPos = puzzle->getEmptyPos();
+    int count = puzzle->lineLength(tilePos);
+    int step = (tilePos - emptyPos) / count;
+
     isAnimating = true;
-    animStartTime = millis();
-    animFromPos = fromPos;
-    animToPos = toPos;
-    animTileNum = tileNum;
+    animFromPos = emptyPos;
+    animToPos = tilePos;
+    animCount = count;
+
+    // Block origin: the top-left source cell; it lands one cell toward the slot
+    int firstPos = (step > 0) ? emptyPos + step : tilePos;
+    int originX = offsetX + (firstPos % gridSize) * tileSize;
+    int originY = offsetY + (firstPos / gridSize) * tileSize;
+    for (int i = 0; i < count; i++) {
+        int pos = emptyPos + (i + 1) * step;
+        animTiles[i] = puzzle->getTile(pos);
+        animTileDX[i] = offsetX + (pos % gridSize) * tileSize - originX;
+        animTileDY[i] = offsetY + (pos / gridSize) * tileSize - originY;
+    }
+    bool horizontal = (step == 1 || step == -1);
+    animBlockW = horizontal ? count * tileSize : tileSize;
+    animBlockH = horizontal ? tileSize : count * tileSize;
+
+    int landX = offsetX + ((firstPos - step) % gridSize) * tileSize;
+    int landY = offsetY + ((firstPos - step) / gridSize) * tileSize;
+    slide.fromX = originX;
+    slide.fromY = originY;
+    slide.toX = landX;
+    slide.toY = landY;
+    slide.durationUs = ANIM_DURATION_MS * 1000;
+    slide.curve = EASE_OUT_CUBIC;
+    animPrevX = slide.fromX;
+    animPrevY = slide.fromY;
+    animPacer.start(micros());
 }
 
 // ==============================================================================
 // Update animation state and draw animating tile
+// Renders at most one frame per pacer tick: only the strip the tile just
+// uncovered and the tile itself are redrawn, then flushed to the panel.
 // Returns true if animation is complete
 // ==============================================================================
 bool updateAnimation() {
     if (!isAnimating || !puzzle) return true;
 
-    unsigned long now = millis();
-    unsigned long elapsed = now - animStartTime;
+    uint32_t now = micros();
+    if (!animPacer.due(now)) return false;
+    uint32_t t = animPacer.beginFrame(now);
 
-    if (elapsed >= ANIM_DURATION_MS) {
+    if (slide.isDone(t)) {
         // Animation complete
         isAnimating = false;
+        char label[24];
+        snprintf(label, sizeof(label), "Slide %dx%d", puzzle->getGridSize(), puzzle->getGridSize());
+        animPacer.printStats(label);
         return true;
     }
 
-    // Calculate interpolation factor (0.0 to 1.0)
-    float t = (float)elapsed / (float)ANIM_DURATION_MS;
+    int gridSize = puzzle->getGridSize();
+    int tileSize = GAME_AREA_SIZE / gridSize;
+    int offsetX = (480 - tileSize * gridSize) / 2;
+    int offsetY = GAME_AREA_Y + (GAME_AREA_SIZE - tileSize * gridSize) / 2;
+
+    int currentX, currentY;
+    slide.position(t, currentX, currentY);
+
+    {
+        Blitter::Frame frame(compositor.painter());
+
+        // Background where the block was last frame and no longer is
+        int sx, sy, sw, sh;
+        if (SlideAnimation::uncovered(animPrevX, animPrevY, currentX, currentY,
+                                      animBlockW, animBlockH, sx, sy, sw, sh)) {
+            compositor.damage(sx, sy, sw, sh);
+            compositor.painter().fill(sx, sy, sw, sh, COL_EMPTY);
+        }
+
+        // Draw the moving tiles at the block's eased position
+        for (int i = 0; i < animCount; i++) {
+            drawTile(animTiles[i], 0, gridSize, tileSize, offsetX, offsetY,
+                     currentX + animTileDX[i], currentY + animTileDY[i]);
+        }
+    }
+    animPrevX = currentX;
+    animPrevY = currentY;
+
+    compositor.flush();
+    animPacer.endFrame(micros());
+    return false;
+}
 
+// ==============================================================================
+// Slide a tile in the empty slot's row or column, with the tiles between it
+// and the slot: feedback, timer, animation, then the puzzle state (shared by
+// touch and the auto-solve demo)
+// ==============================================================================
+void playMove(int tilePos) {
     int gridSize = puzzle->getGridSize();
     int tileSize = GAME_AREA_SIZE / gridSize;
     int offsetX = (480 - tileSize * gridSize) / 2;
     int offsetY = GAME_AREA_Y + (GAME_AREA_SIZE - tileSize * gridSize) / 2;
 
-    // Calculate from/to positions in pixels
-    int fromRow = animFromPos / gridSize;
-    int fromCol = animFromPos % gridSize;
-    int fromX = offsetX + fromCol * tileSize;
-    int fromY = offsetY + fromRow * tileSize;
-
-    int toRow = animToPos / gridSize;
-    int toCol = animToPos % gridSize;
-    int toX = offsetX + toCol * tileSize;
-    int toY = offsetY + toRow * tileSize;
-
-    // Linear interpolation
-    int currentX = fromX + (int)((toX - fromX) * t);
-    int currentY = fromY + (int)((toY - fromY) * t);
-
-    // Clear previous position trail (draw empty tile behind)
-    // We need to clear the path between from and to
-    if (fromX == toX) {
-        // Vertical movement
-        int y1 = min(fromY, toY);
-        int y2 = max(fromY, toY) + tileSize;
-        tft.fillRect(fromX, y1, tileSize, y2 - y1, COL_EMPTY);
-    } else {
-        // Horizontal movement
-        int x1 = min(fromX, toX);
-        int x2 = max(fromX, toX) + tileSize;
-        tft.fillRect(x1, fromY, x2 - x1, tileSize, COL_EMPTY);
+    // Show valid tile feedback (bright border)
+    flashTile = tilePos;
+    flashStartTime = millis();
+    flashDuration = FLASH_DURATION_MS;
+    flashKind = OVERLAY_VALID;
+    drawFlashFeedback(tilePos, gridSize, tileSize, offsetX, offsetY, flashKind);
+
+    #ifdef ENABLE_SOUND
+    playSlideSound();
+    #endif
+
+    // Start timer on first move
+    if (!timerRunning && gameStartTime == 0) {
+        gameStartTime = millis();
+        timerRunning = true;
     }
 
-    // Draw the animating tile at interpolated position
-    drawTile(animTileNum, animToPos, gridSize, tileSize, offsetX, offsetY, currentX, currentY);
+    // Start animation before moving the run in puzzle state
+    startLineAnimation(tilePos);
 
-    return false;
+    // Move every tile between tilePos and the empty slot (one move each)
+    puzzle->moveLine(tilePos);
+
+    // Note: Win check will happen after animation completes in loop()
+}
+
+// ==============================================================================
+// End the slide (on schedule, or early when the player taps again): tiles at
+// their final cells, then the win check
+// ==============================================================================
+void finishAnimation() {
+    isAnimating = false;
+
+    // Redraw the whole line to ensure clean final state
+    // animFromPos now has a tile, animToPos is the empty slot
+    redrawMovedTiles(animFromPos, animToPos);
+    compositor.flush();
+
+    // Check for win condition
+    if (puzzle && puzzle->isWon()) {
+        timerRunning = false;
+        gameEndTime = millis();
+        Serial.println("PUZZLE SOLVED!");
+
+        #ifdef ENABLE_SOUND
+        playWinSound();
+        #endif
+
+        delay(500);  // Brief pause before win screen
+        showWinScreen();
+    }
 }
 
 // ==============================================================================
@@ -697,10 +870,10 @@ bool updateAnimation() {
 void handleGameTouch(int x, int y) {
     if (!puzzle) return;
 
-    // Block touch input during animation
+    // A tap during a slide snaps it to its end, then counts as a new tap
     if (isAnimating) {
-        Serial.println("Touch blocked: animation in progress");
-        return;
+        finishAnimation();
+        if (gameState != PLAYING) return;
     }
 
     int gridSize = puzzle->getGridSize();
@@ -708,23 +881,25 @@ void handleGameTouch(int x, int y) {
     int offsetX = (480 - tileSize * gridSize) / 2;
     int offsetY = GAME_AREA_Y + (GAME_AREA_SIZE - tileSize * gridSize) / 2;
 
-    // Check button bar
-    int barY = 480 - BUTTON_BAR_HEIGHT;
-    if (y >= barY) {
-        if (inRect(x, y, 10, barY + 5, 140, 40)) {
+    Widget* hit = gameScene.hitTest(x, y);
+    if (hit != &gameScene.board) {
+        if (hit == &gameScene.back) {
             // Back button
             Serial.println("Back to puzzle select");
-            if (puzzleImageBuffer) { free(puzzleImageBuffer); puzzleImageBuffer = nullptr; }
+            demoActive = false;
+            releasePuzzleImage();
             if (puzzle) { delete puzzle; puzzle = nullptr; }
-            showPuzzleSelect(selectedDifficulty);
+            showPuzzleSelect(selectedDifficulty, selectScene.page());
             return;
         }
-        if (inRect(x, y, 330, barY + 5, 140, 40)) {
-            // Restart button
+        if (hit == &gameScene.restart) {
+            // Restart button: same seed, so the same board (from the cache)
             Serial.println("Restarting puzzle");
-            int shuffleMoves = (gridSize == 3) ? 50 : (gridSize == 4) ? 150 : 300;
+            pressBarButton(gameScene.restart);
+            demoActive = false;
+            demoUsed = false;
             puzzle->reset();
-            puzzle->shuffle(shuffleMoves);
+            applyScramble(puzzle->getScrambleSeed());
             gameStartTime = 0;
             gameEndTime = 0;
             timerRunning = false;
@@ -733,56 +908,55 @@ void handleGameTouch(int x, int y) {
             drawGameScreen();
             return;
         }
+        if (hit == &gameScene.solve) {
+            // Solve button: start or stop the auto-solve demo
+            pressBarButton(gameScene.solve);
+            if (demoActive) stopDemo();
+            else startDemo();
+            return;
+        }
+        if (demoActive) return;
+        if (hit == &gameScene.hint) {
+            // Hint button: budgeted search, highlight the suggested tile
+            pressBarButton(gameScene.hint);
+            SolveResult hint = hintEngine.findHint(*puzzle, HINT_BUDGET);
+            Serial.printf("Hint: tile pos %d (%s, len %d, bound %d) %u nodes in %u us, %u nodes/s\n",
+                          hint.hintTilePos, hint.solved ? "optimal" : "near-optimal",
+                          hint.solutionLength, hint.lowerBound,
+                          (unsigned)hint.nodesExpanded, (unsigned)hint.elapsedUs, (unsigned)hint.nodesPerSecond);
+            if (hint.hintTilePos >= 0) {
+                clearFlashFeedback();
+                flashTile = hint.hintTilePos;
+                flashStartTime = millis();
+                flashDuration = HINT_FLASH_MS;
+                flashKind = OVERLAY_HINT;
+                drawFlashFeedback(flashTile, gridSize, tileSize, offsetX, offsetY, flashKind);
+            }
+            return;
+        }
         return;
     }
 
-    // Check if touch is in grid area
-    int gridX = x - offsetX;
-    int gridY = y - offsetY;
-    if (gridX < 0 || gridY < 0 || gridX >= tileSize * gridSize || gridY >= tileSize * gridSize) {
-        return;
-    }
-
-    int col = gridX / tileSize;
-    int row = gridY / tileSize;
-    int tilePos = row * gridSize + col;
-
-    Serial.printf("Touch grid [%d,%d] pos=%d tile=%d\n", row, col, tilePos, puzzle->getTile(tilePos));
+    // The board belongs to the demo while it runs
+    if (demoActive) return;
 
-    if (puzzle->canMove(tilePos)) {
-        int oldEmptyPos = puzzle->getEmptyPos();
-        int tileNum = puzzle->getTile(tilePos);
+    int tilePos = gameScene.board.cellAt(x, y);
+    Serial.printf("Touch grid [%d,%d] pos=%d tile=%d\n", tilePos / gridSize, tilePos % gridSize,
+                  tilePos, puzzle->getTile(tilePos));
 
-        // Show valid tile feedback (bright border)
-        flashTile = tilePos;
-        flashStartTime = millis();
-        flashColor = COL_FLASH_VALID;
-        drawFlashFeedback(tilePos, gridSize, tileSize, offsetX, offsetY, flashColor);
-
-        #ifdef ENABLE_SOUND
-        playSlideSound();
-        #endif
-
-        // Start timer on first move
-        if (!timerRunning && gameStartTime == 0) {
-            gameStartTime = millis();
-            timerRunning = true;
-        }
+    // Drop a lingering hint highlight before showing new feedback
+    clearFlashFeedback();
 
-        // Start animation before moving tile in puzzle state
-        startTileAnimation(tilePos, oldEmptyPos, tileNum);
-
-        // Move tile in puzzle state
-        puzzle->moveTile(tilePos);
-
-        // Note: Win check will happen after animation completes in loop()
+    if (puzzle->lineLength(tilePos) > 0) {
+        playMove(tilePos);
     } else {
         // Invalid tile - show red flash
         Serial.println("Invalid move - tile can't move");
         flashTile = tilePos;
         flashStartTime = millis();
-        flashColor = COL_FLASH_INVALID;
-        drawFlashFeedback(tilePos, gridSize, tileSize, offsetX, offsetY, flashColor);
+        flashDuration = FLASH_DURATION_MS;
+        flashKind = OVERLAY_INVALID;
+        drawFlashFeedback(tilePos, gridSize, tileSize, offsetX, offsetY, flashKind);
 
         #ifdef ENABLE_SOUND
         playErrorSound();
@@ -795,69 +969,41 @@ void handleGameTouch(int x, int y) {
 // ==============================================================================
 void showWinScreen() {
     gameState = WIN_SCREEN;
-
-    unsigned long secs = getGameSeconds();
-    int moves = puzzle ? puzzle->getMoveCount() : 0;
-
-    tft.fillScreen(COL_WIN_BG);
-
-    // Show completed puzzle image briefly behind
-    if (puzzleImageBuffer) {
-        // Draw small centered preview of solved image
-        int previewSize = 200;
-        int px = (480 - previewSize) / 2;
-        int py = 30;
-        uint16_t* lineBuffer = (uint16_t*)malloc(previewSize * sizeof(uint16_t));
-        if (lineBuffer) {
-            for (int dy = 0; dy < previewSize; dy++) {
-                int sy = (dy * 480) / previewSize;
-                for (int dx = 0; dx < previewSize; dx++) {
-                    int sx = (dx * 480) / previewSize;
-                    lineBuffer[dx] = puzzleImageBuffer[sy * 480 + sx];
-                }
-                tft.pushImage(px, py + dy, previewSize, 1, lineBuffer);
-            }
-            free(lineBuffer);
-        }
-        tft.drawRect(px - 1, py - 1, previewSize + 2, previewSize + 2, COL_GOLD);
-        tft.drawRect(px - 2, py - 2, previewSize + 4, previewSize + 4, COL_GOLD);
+    compositor.discard();
+    statusBar.invalidate();
+    shownScene = nullptr;
+
+    WinView view = {};
+    view.image = blobView.tiles ? blobView.preview : puzzleImage;
+    view.imageSize = blobView.tiles ? blobView.previewSize : 480;
+    view.moves = puzzle ? puzzle->getMoveCount() : 0;
+    view.seconds = getGameSeconds();
+    view.optimal = puzzle ? puzzle->getOptimalLength() : -1;
+    view.demoUsed = demoUsed;
+    view.difficulty = selectedDifficulty;
+    winScene.set(view);
+    showScene(winScene);
+
+    // Prepare the next board while the player reads the stats
+    if (puzzle) {
+        pendingSeed = newScrambleSeed();
+        scrambleGenerator.prepare(puzzle->getGridSize(), pendingSeed);
     }
-
-    // "You Win!" text
-    tft.setTextColor(COL_GOLD);
-    tft.setTextDatum(textdatum_t::middle_center);
-    tft.setTextSize(4);
-    tft.drawString("YOU WIN!", 240, 260);
-
-    // Stats
-    tft.setTextSize(2);
-    tft.setTextColor(COL_WHITE);
-    char buf[64];
-    snprintf(buf, sizeof(buf), "Moves: %d    Time: %s", moves, formatTime(secs).c_str());
-    tft.drawString(buf, 240, 310);
-
-    // Difficulty label
-    const char* diffNames[] = {"Easy (3x3)", "Medium (4x4)", "Hard (5x5)"};
-    tft.setTextSize(2);
-    tft.setTextColor(0xBDF7);
-    tft.drawString(diffNames[selectedDifficulty], 240, 345);
-
-    // Buttons
-    tft.setTextSize(2);
-    drawButton(50, 400, 170, 50, COL_BTN_MED, "Play Again", COL_BLACK);
-    drawButton(260, 400, 170, 50, COL_BTN, "Menu");
 }
 
 // ==============================================================================
 // Handle touch on win screen
 // ==============================================================================
 void handleWinTouch(int x, int y) {
-    if (inRect(x, y, 50, 400, 170, 50)) {
+    Widget* hit = winScene.hitTest(x, y);
+    if (hit == &winScene.again) {
         // Play Again - same puzzle
+        pressButton(winScene, winScene.again);
         startGame(selectedDifficulty, selectedPuzzle);
-    } else if (inRect(x, y, 260, 400, 170, 50)) {
+    } else if (hit == &winScene.menu) {
         // Menu
-        if (puzzleImageBuffer) { free(puzzleImageBuffer); puzzleImageBuffer = nullptr; }
+        pressButton(winScene, winScene.menu);
+        releasePuzzleImage();
         if (puzzle) { delete puzzle; puzzle = nullptr; }
         showMainMenu();
     }
@@ -867,40 +1013,36 @@ void handleWinTouch(int x, int y) {
 // Handle touch on main menu
 // ==============================================================================
 void handleMenuTouch(int x, int y) {
-    int btnW = 300, btnH = 60;
-    int btnX = (480 - btnW) / 2;
-
-    if (inRect(x, y, btnX, 260, btnW, btnH)) {
-        showPuzzleSelect(0);  // Easy
-    } else if (inRect(x, y, btnX, 340, btnW, btnH)) {
-        showPuzzleSelect(1);  // Medium
-    } else if (inRect(x, y, btnX, 420, btnW, btnH)) {
-        showPuzzleSelect(2);  // Hard
-    }
+    int difficulty = menuScene.difficultyOf(menuScene.hitTest(x, y));
+    if (difficulty < 0) return;
+    pressButton(menuScene, *menuScene.button(difficulty));
+    showPuzzleSelect(difficulty);
 }
 
 // ==============================================================================
 // Handle touch on puzzle select
 // ==============================================================================
 void handlePuzzleSelectTouch(int x, int y) {
-    // Back button
-    if (inRect(x, y, 10, 430, 120, 40)) {
+    Widget* hit = selectScene.hitTest(x, y);
+    if (hit == &selectScene.back) {
+        pressButton(selectScene, selectScene.back);
         showMainMenu();
         return;
     }
 
-    // Puzzle buttons
-    int btnW = 420, btnH = 55;
-    int btnX = (480 - btnW) / 2;
-    int startY = 95;
+    if (hit == &selectScene.more) {
+        pressButton(selectScene, selectScene.more);
+        selectScene.set(selectedDifficulty, puzzleManager, selectScene.page() + 1);
+        selectScene.draw(screen, blitter);
+        prefetchShownPuzzles();
+        return;
+    }
 
-    const auto& puzzles = puzzleManager.getPuzzles(selectedDifficulty);
-    for (int i = 0; i < (int)puzzles.size() && i < 5; i++) {
-        int btnY = startY + i * 65;
-        if (inRect(x, y, btnX, btnY, btnW, btnH)) {
-            startGame(selectedDifficulty, i);
-            return;
-        }
+    // Puzzle buttons (hidden beyond the difficulty's puzzle count)
+    int index = selectScene.puzzleOf(hit);
+    if (index >= 0) {
+        pressButton(selectScene, *selectScene.button(index));
+        startGame(selectedDifficulty, index);
     }
 }
 
@@ -949,6 +1091,27 @@ void setup() {
 
     puzzleManager.listFiles();
 
+    // Pre-scaled puzzles in the "assets" partition (optional, files otherwise)
+    assetBlob.begin(puzzleManager.getCatalogCrc(), puzzleManager.getTotalCount());
+
+    // Optimal 3x3 hints without search (optional asset, IDA* otherwise)
+    if (hintTable3.load(LittleFS)) hintEngine.setTable3(&hintTable3);
+    // 4x4 pattern databases (optional asset, ~770 KB in PSRAM)
+    if (patternDb4.load(LittleFS, PDB_IN_PSRAM)) hintEngine.setPatternDatabase(&patternDb4);
+
+    // Game screen back buffer (falls back to drawing direct without PSRAM)
+    if (backBuffer.create(480, 480)) {
+        compositor.begin(backBuffer);
+    } else {
+        Serial.println("Compositor: no PSRAM for back buffer, drawing direct");
+    }
+
+    // Status bar glyphs, rasterized once through a small scratch sprite
+    {
+        LGFXSpriteTarget glyphScratch(&tft);
+        if (glyphScratch.create(480, 8 * STATUS_TEXT_SIZE)) statusBar.begin(glyphScratch);
+    }
+
     // 4. Initialize sound (if enabled)
     #ifdef ENABLE_SOUND
     initSound();
@@ -972,46 +1135,38 @@ void loop() {
     if (gameState == PLAYING && isAnimating) {
         bool animComplete = updateAnimation();
 
-        if (animComplete) {
-            // Animation finished - redraw tiles at final positions
-            isAnimating = false;
-
-            // Redraw both positions to ensure clean final state
-            // animFromPos now has empty tile, animToPos now has the moved tile
-            redrawMovedTiles(animFromPos, animToPos);
-
-            // Check for win condition
-            if (puzzle && puzzle->isWon()) {
-                timerRunning = false;
-                gameEndTime = millis();
-                Serial.println("PUZZLE SOLVED!");
-
-                #ifdef ENABLE_SOUND
-                playWinSound();
-                #endif
+        if (animComplete) finishAnimation();
+    }
 
-                delay(500);  // Brief pause before win screen
-                showWinScreen();
-            }
+    // Auto-solve demo: next planned move once the previous one has landed
+    if (gameState == PLAYING && demoActive && !isAnimating && puzzle &&
+        now - lastDemoStep >= DEMO_STEP_MS) {
+        int tilePos = demoIndex < demoLength ? puzzle->getNeighborPos(demoPlan[demoIndex++]) : -1;
+        if (tilePos >= 0) {
+            clearFlashFeedback();
+            playMove(tilePos);
+            lastDemoStep = now;
         }
+        if (tilePos < 0 || demoIndex >= demoLength) stopDemo();
+    }
+
+    // Release a pressed bar button
+    if (pressedButton && now - pressedTime >= BUTTON_PRESS_MS) {
+        pressedButton->setPressed(false);
+        pressedButton = nullptr;
+        if (gameState == PLAYING) drawButtonBar();
     }
 
     // Clear flash feedback after duration
-    if (gameState == PLAYING && flashTile >= 0 && (now - flashStartTime >= FLASH_DURATION_MS)) {
+    if (gameState == PLAYING && flashTile >= 0 && (now - flashStartTime >= flashDuration)) {
         // Redraw the tile to clear flash effect
-        if (puzzle && !isAnimating) {
-            int gridSize = puzzle->getGridSize();
-            int tileSize = GAME_AREA_SIZE / gridSize;
-            int offsetX = (480 - tileSize * gridSize) / 2;
-            int offsetY = GAME_AREA_Y + (GAME_AREA_SIZE - tileSize * gridSize) / 2;
-
-            // Only redraw if the tile is still in the same position (not animating)
-            drawTile(puzzle->getTile(flashTile), flashTile, gridSize, tileSize, offsetX, offsetY);
-        }
-        flashTile = -1;
+        clearFlashFeedback();
     }
 
-    // Touch press detection with debounce (not during animation)
+    // Background image prefetch, one slice per pass while the list is up
+    if (gameState == PUZZLE_SELECT && !touching) imageCache.step(PREFETCH_SLICE_US);
+
+    // Touch press detection with debounce (a tap during a slide snaps it)
     if (touching && !lastTouchState && (now - lastTouchTime > TOUCH_DEBOUNCE_MS)) {
         lastTouchTime = now;
         Serial.printf("Touch at (%d, %d) state=%d\n", x, y, (int)gameState);
@@ -1034,10 +1189,20 @@ void loop() {
 
     lastTouchState = touching;
 
-    // Update timer display during gameplay (but not during animation to avoid flicker)
-    if (gameState == PLAYING && timerRunning && !isAnimating) {
+    // Update timer display during gameplay (glyph cells only, so also mid-slide)
+    if (gameState == PLAYING && timerRunning) {
         drawStatusBar();
     }
 
-    delay(10);
+    // Everything the game screen drew this pass reaches the panel at once
+    if (gameState == PLAYING) compositor.flush();
+
+    // While a tile slides, sleep only until the next frame tick
+    if (gameState == PLAYING && isAnimating) {
+        uint32_t waitUs = animPacer.untilNextUs(micros());
+        if (waitUs >= 1000) delay(waitUs / 1000);
+        delayMicroseconds(waitUs % 1000);
+    } else {
+        delay(10);
+    }
 }
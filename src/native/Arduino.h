@@ -0,0 +1,112 @@
+#pragma once
+
+// ==============================================================================
+// Host Arduino Shim
+// Minimal stand-in for the Arduino core so the engine and catalog headers
+// build on Linux ([env:native]). Only what the game code actually uses.
+// ==============================================================================
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdarg>
+#include <cmath>
+#include <string>
+#include <algorithm>
+
+using std::abs;
+using std::min;
+using std::max;
+
+// --- Time ---
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+// --- RNG (Arduino semantics: random(max) in [0, max), random(min, max) in [min, max)) ---
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+
+// --- Memory (PSRAM is plain heap on the host) ---
+inline void* ps_malloc(size_t size) { return malloc(size); }
+inline void* ps_calloc(size_t n, size_t size) { return calloc(n, size); }
+
+// --- String ---
+class String {
+private:
+    std::string s;
+
+public:
+    String() {}
+    String(const char* str) : s(str ? str : "") {}
+    String(const std::string& str) : s(str) {}
+    String(char c) : s(1, c) {}
+    String(int v) : s(std::to_string(v)) {}
+    String(unsigned int v) : s(std::to_string(v)) {}
+    String(long v) : s(std::to_string(v)) {}
+    String(unsigned long v) : s(std::to_string(v)) {}
+
+    const char* c_str() const { return s.c_str(); }
+    unsigned int length() const { return (unsigned int)s.length(); }
+    bool isEmpty() const { return s.empty(); }
+
+    bool endsWith(const String& suffix) const {
+        return s.size() >= suffix.s.size() &&
+               s.compare(s.size() - suffix.s.size(), suffix.s.size(), suffix.s) == 0;
+    }
+    bool startsWith(const String& prefix) const {
+        return s.compare(0, prefix.s.size(), prefix.s) == 0;
+    }
+
+    String& operator+=(const String& rhs) { s += rhs.s; return *this; }
+    String& operator+=(const char* rhs) { s += rhs; return *this; }
+    String& operator+=(char c) { s += c; return *this; }
+
+    friend String operator+(const String& a, const String& b) { return String(a.s + b.s); }
+    friend String operator+(const String& a, const char* b) { return String(a.s + b); }
+    friend String operator+(const char* a, const String& b) { return String(a + b.s); }
+
+    bool operator==(const String& rhs) const { return s == rhs.s; }
+    bool operator!=(const String& rhs) const { return s != rhs.s; }
+    bool operator<(const String& rhs) const { return s < rhs.s; }
+};
+
+// --- Serial (stdout unless redirected) ---
+class HostSerial {
+private:
+    FILE* out = stdout;
+
+public:
+    void begin(unsigned long) {}
+
+    // Tools whose stdout is data (e.g. batch_solve's CSV) send logs elsewhere
+    void setStream(FILE* stream) { out = stream; }
+
+    size_t print(const char* str) { return fputs(str, out) >= 0 ? strlen(str) : 0; }
+    size_t print(const String& str) { return print(str.c_str()); }
+    size_t print(char c) { return fputc(c, out) != EOF ? 1 : 0; }
+    size_t print(int v) { return printf("%d", v); }
+    size_t print(unsigned int v) { return printf("%u", v); }
+    size_t print(long v) { return printf("%ld", v); }
+    size_t print(unsigned long v) { return printf("%lu", v); }
+    size_t print(double v) { return printf("%.2f", v); }
+
+    size_t println() { return print('\n'); }
+    template <typename T>
+    size_t println(const T& v) { size_t n = print(v); return n + println(); }
+
+    size_t printf(const char* fmt, ...) {
+        va_list args;
+        va_start(args, fmt);
+        int n = vfprintf(out, fmt, args);
+        va_end(args);
+        return n > 0 ? (size_t)n : 0;
+    }
+
+    void flush() { fflush(out); }
+};
+
+extern HostSerial Serial;
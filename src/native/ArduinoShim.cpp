@@ -0,0 +1,286 @@
+// ==============================================================================
+// Host Arduino Shim - implementation
+// ==============================================================================
+
+#include "Arduino.h"
+#include "LittleFS.h"
+#include "esp_partition.h"
+
+#include <chrono>
+#include <thread>
+#include <random>
+#include <filesystem>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace stdfs = std::filesystem;
+
+HostSerial Serial;
+fs::LittleFSFS LittleFS;
+
+// ==============================================================================
+// Time
+// ==============================================================================
+static const auto bootTime = std::chrono::steady_clock::now();
+
+unsigned long millis() {
+    auto d = std::chrono::steady_clock::now() - bootTime;
+    return (unsigned long)std::chrono::duration_cast<std::chrono::milliseconds>(d).count();
+}
+
+unsigned long micros() {
+    auto d = std::chrono::steady_clock::now() - bootTime;
+    return (unsigned long)std::chrono::duration_cast<std::chrono::microseconds>(d).count();
+}
+
+void delay(unsigned long ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void delayMicroseconds(unsigned int us) {
+    std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+// ==============================================================================
+// RNG
+// ==============================================================================
+static std::mt19937 rng(0x5EED);
+
+long random(long howbig) {
+    if (howbig <= 0) return 0;
+    return (long)(rng() % (uint32_t)howbig);
+}
+
+long random(long howsmall, long howbig) {
+    if (howsmall >= howbig) return howsmall;
+    return howsmall + random(howbig - howsmall);
+}
+
+void randomSeed(unsigned long seed) {
+    if (seed != 0) rng.seed((uint32_t)seed);
+}
+
+// ==============================================================================
+// File system
+// ==============================================================================
+namespace fs {
+
+class FileImpl {
+public:
+    std::string fsPath;     // Path within the FS root
+    std::string baseName;
+    FILE* fp = nullptr;
+    size_t fileSize = 0;
+
+    // Directory iteration
+    bool isDir = false;
+    std::string hostDir;
+    std::vector<std::string> entries;
+    size_t nextEntry = 0;
+    const FS* owner = nullptr;
+
+    ~FileImpl() { if (fp) fclose(fp); }
+};
+
+File::operator bool() const {
+    return impl && (impl->fp || impl->isDir);
+}
+
+size_t File::read(uint8_t* buf, size_t size) {
+    if (!impl || !impl->fp) return 0;
+    return fread(buf, 1, size, impl->fp);
+}
+
+int File::read() {
+    uint8_t b;
+    return read(&b, 1) == 1 ? b : -1;
+}
+
+size_t File::write(const uint8_t* buf, size_t size) {
+    if (!impl || !impl->fp) return 0;
+    size_t n = fwrite(buf, 1, size, impl->fp);
+    long pos = ftell(impl->fp);
+    if (pos > 0 && (size_t)pos > impl->fileSize) impl->fileSize = (size_t)pos;
+    return n;
+}
+
+bool File::seek(uint32_t pos) {
+    if (!impl || !impl->fp) return false;
+    return fseek(impl->fp, (long)pos, SEEK_SET) == 0;
+}
+
+size_t File::position() const {
+    if (!impl || !impl->fp) return 0;
+    long pos = ftell(impl->fp);
+    return pos < 0 ? 0 : (size_t)pos;
+}
+
+size_t File::size() const {
+    return impl ? impl->fileSize : 0;
+}
+
+int File::available() const {
+    if (!impl || !impl->fp) return 0;
+    return (int)(impl->fileSize - position());
+}
+
+void File::close() {
+    impl.reset();
+}
+
+bool File::isDirectory() const {
+    return impl && impl->isDir;
+}
+
+File File::openNextFile() {
+    if (!impl || !impl->isDir || impl->nextEntry >= impl->entries.size()) return File();
+    std::string child = impl->fsPath;
+    if (child.empty() || child.back() != '/') child += '/';
+    child += impl->entries[impl->nextEntry++];
+    return const_cast<FS*>(impl->owner)->open(child.c_str(), "r");
+}
+
+const char* File::name() const {
+    return impl ? impl->baseName.c_str() : "";
+}
+
+const char* File::path() const {
+    return impl ? impl->fsPath.c_str() : "";
+}
+
+std::string FS::hostPath(const char* path) const {
+    std::string p = root;
+    if (path && path[0] != '/') p += '/';
+    if (path) p += path;
+    return p;
+}
+
+File FS::open(const char* path, const char* mode) {
+    std::string hp = hostPath(path);
+    std::error_code ec;
+
+    auto impl = std::make_shared<FileImpl>();
+    impl->fsPath = path;
+    impl->baseName = stdfs::path(path).filename().string();
+    impl->owner = this;
+
+    if (stdfs::is_directory(hp, ec)) {
+        impl->isDir = true;
+        impl->hostDir = hp;
+        for (const auto& e : stdfs::directory_iterator(hp, ec)) {
+            impl->entries.push_back(e.path().filename().string());
+        }
+        std::sort(impl->entries.begin(), impl->entries.end());
+        return File(impl);
+    }
+
+    const char* fmode = "rb";
+    if (mode && mode[0] == 'w') fmode = "wb";
+    else if (mode && mode[0] == 'a') fmode = "ab";
+
+    impl->fp = fopen(hp.c_str(), fmode);
+    if (!impl->fp) return File();
+
+    if (fmode[0] == 'r') {
+        fseek(impl->fp, 0, SEEK_END);
+        long sz = ftell(impl->fp);
+        fseek(impl->fp, 0, SEEK_SET);
+        impl->fileSize = sz < 0 ? 0 : (size_t)sz;
+    }
+    return File(impl);
+}
+
+bool FS::exists(const char* path) const {
+    std::error_code ec;
+    return stdfs::exists(hostPath(path), ec);
+}
+
+bool FS::remove(const char* path) {
+    std::error_code ec;
+    return stdfs::remove(hostPath(path), ec);
+}
+
+bool FS::mkdir(const char* path) {
+    std::error_code ec;
+    return stdfs::create_directories(hostPath(path), ec) || stdfs::is_directory(hostPath(path), ec);
+}
+
+// ==============================================================================
+// LittleFS
+// ==============================================================================
+bool LittleFSFS::begin(bool, const char*, uint8_t, const char*) {
+    if (root.empty()) {
+        const char* env = getenv("PUZZLE_DATA_DIR");
+        root = env ? env : "data";
+    }
+    std::error_code ec;
+    mounted = stdfs::is_directory(root, ec);
+    return mounted;
+}
+
+size_t LittleFSFS::totalBytes() {
+    return 0x6C0000;  // Matches the spiffs partition in partitions_custom.csv
+}
+
+size_t LittleFSFS::usedBytes() {
+    size_t used = 0;
+    std::error_code ec;
+    for (const auto& e : stdfs::recursive_directory_iterator(root, ec)) {
+        if (e.is_regular_file(ec)) used += (size_t)e.file_size(ec);
+    }
+    return used;
+}
+
+}  // namespace fs
+
+// ==============================================================================
+// esp_partition: "assets" is a read-only mmap of $PUZZLE_BLOB (./assets.blob)
+// ==============================================================================
+static esp_partition_t assetsPartition;
+static const uint8_t* assetsData = nullptr;
+
+const esp_partition_t* esp_partition_find_first(esp_partition_type_t type, esp_partition_subtype_t subtype,
+                                                const char* label) {
+    if (type != ESP_PARTITION_TYPE_DATA || (subtype != ESP_PARTITION_SUBTYPE_ANY && subtype != 0x40) ||
+        (label && strcmp(label, "assets") != 0)) {
+        return nullptr;
+    }
+    if (!assetsData) {
+        const char* env = getenv("PUZZLE_BLOB");
+        int fd = open(env ? env : "assets.blob", O_RDONLY);
+        if (fd < 0) return nullptr;
+        struct stat st;
+        void* data = fstat(fd, &st) == 0 && st.st_size > 0
+                         ? mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+        close(fd);
+        if (data == MAP_FAILED) return nullptr;
+        assetsData = (const uint8_t*)data;
+        assetsPartition.type = ESP_PARTITION_TYPE_DATA;
+        assetsPartition.subtype = (esp_partition_subtype_t)0x40;
+        assetsPartition.address = 0x240000;  // As in partitions_blob.csv
+        assetsPartition.size = (uint32_t)st.st_size;
+        strcpy(assetsPartition.label, "assets");
+    }
+    return &assetsPartition;
+}
+
+esp_err_t esp_partition_read(const esp_partition_t* partition, size_t src_offset, void* dst, size_t size) {
+    if (partition != &assetsPartition || !assetsData) return ESP_ERR_INVALID_ARG;
+    if (src_offset > partition->size || size > partition->size - src_offset) return ESP_ERR_INVALID_SIZE;
+    memcpy(dst, assetsData + src_offset, size);
+    return ESP_OK;
+}
+
+esp_err_t esp_partition_mmap(const esp_partition_t* partition, size_t offset, size_t size,
+                             spi_flash_mmap_memory_t, const void** out_ptr,
+                             spi_flash_mmap_handle_t* out_handle) {
+    if (partition != &assetsPartition || !assetsData) return ESP_ERR_INVALID_ARG;
+    if (offset > partition->size || size > partition->size - offset) return ESP_ERR_INVALID_SIZE;
+    *out_ptr = assetsData + offset;
+    *out_handle = 1;
+    return ESP_OK;
+}
+
+void spi_flash_munmap(spi_flash_mmap_handle_t) {}
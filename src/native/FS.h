@@ -0,0 +1,65 @@
+#pragma once
+
+// ==============================================================================
+// Host FS Shim
+// Directory-backed replacement for the Arduino fs::FS / fs::File API.
+// Paths are absolute within the mounted root ("/puzzles/easy/castle.rgb565").
+// ==============================================================================
+
+#include "Arduino.h"
+#include <memory>
+#include <vector>
+
+namespace fs {
+
+class FileImpl;
+
+class File {
+private:
+    std::shared_ptr<FileImpl> impl;
+
+public:
+    File() {}
+    explicit File(std::shared_ptr<FileImpl> p) : impl(std::move(p)) {}
+
+    explicit operator bool() const;
+
+    size_t read(uint8_t* buf, size_t size);
+    int read();
+    size_t write(const uint8_t* buf, size_t size);
+    bool seek(uint32_t pos);
+    size_t position() const;
+    size_t size() const;
+    int available() const;
+    void close();
+
+    bool isDirectory() const;
+    File openNextFile();
+    const char* name() const;   // Base name, like the ESP32 core
+    const char* path() const;   // Full path within the FS root
+};
+
+class FS {
+protected:
+    std::string root;
+
+    std::string hostPath(const char* path) const;
+
+public:
+    explicit FS(const std::string& rootDir = "") : root(rootDir) {}
+
+    void setRoot(const std::string& rootDir) { root = rootDir; }
+    const std::string& getRoot() const { return root; }
+
+    File open(const char* path, const char* mode = "r");
+    File open(const String& path, const char* mode = "r") { return open(path.c_str(), mode); }
+    bool exists(const char* path) const;
+    bool exists(const String& path) const { return exists(path.c_str()); }
+    bool remove(const char* path);
+    bool mkdir(const char* path);
+};
+
+}  // namespace fs
+
+using fs::File;
+using fs::FS;
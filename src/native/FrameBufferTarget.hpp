@@ -0,0 +1,254 @@
+#pragma once
+
+#include <Arduino.h>
+#include <stdio.h>
+#include <string.h>
+#include "RenderTarget.hpp"
+#include "Font5x7.hpp"
+
+// ==============================================================================
+// FrameBufferTarget
+// Headless RenderTarget for the host: a width x height buffer in the panel's
+// byte-swapped RGB565, so pushImage is a plain copy and the buffer can back a
+// Compositor exactly like the device's PSRAM sprite. Shapes follow LovyanGFX
+// semantics (inclusive lines, clip rectangle, text datum); text uses Font5x7.
+//
+// writePPM/readPPM store 8-bit RGB expanded from RGB565 the way the panel
+// does (bit replication), so a round trip is lossless and goldens can be
+// compared pixel for pixel with countDiff().
+// ==============================================================================
+
+class FrameBufferTarget : public RenderTarget {
+private:
+    int w, h;
+    uint16_t* pixels;
+    int clipX0, clipY0, clipX1, clipY1;     // Half-open
+    uint16_t textColor = 0xFFFF;
+    TextAlign textAlign = TEXT_TOP_LEFT;
+    int textSize = 1;
+
+    static uint16_t swap(uint16_t c) { return (uint16_t)((c << 8) | (c >> 8)); }
+
+    void plot(int x, int y, uint16_t swapped) {
+        if (x < clipX0 || x >= clipX1 || y < clipY0 || y >= clipY1) return;
+        pixels[y * w + x] = swapped;
+    }
+
+    void span(int x0, int x1, int y, uint16_t swapped) {     // [x0, x1)
+        if (y < clipY0 || y >= clipY1) return;
+        x0 = max(x0, clipX0);
+        x1 = min(x1, clipX1);
+        uint16_t* p = pixels + y * w;
+        for (int x = x0; x < x1; x++) p[x] = swapped;
+    }
+
+    // Left/right inset of row `row` of a w x h rounded rectangle
+    static int cornerInset(int row, int rh, int r) {
+        int k = row < r ? row : (row >= rh - r ? rh - 1 - row : -1);
+        if (k < 0) return 0;
+        int dy = r - k;
+        int dx = 0;
+        while ((dx + 1) * (dx + 1) + dy * dy <= r * r) dx++;
+        return r - dx;
+    }
+
+    static int clampRadius(int rw, int rh, int r) {
+        return max(0, min(r, min(rw, rh) / 2));
+    }
+
+public:
+    FrameBufferTarget(int width = 480, int height = 480) : w(width), h(height) {
+        pixels = (uint16_t*)calloc((size_t)w * h, sizeof(uint16_t));
+        clearClipRect();
+    }
+
+    ~FrameBufferTarget() { free(pixels); }
+
+    FrameBufferTarget(const FrameBufferTarget&) = delete;
+    FrameBufferTarget& operator=(const FrameBufferTarget&) = delete;
+
+    int width() const override { return w; }
+    int height() const override { return h; }
+    uint16_t* buffer() override { return pixels; }
+    const uint16_t* buffer() const { return pixels; }
+
+    // Native RGB565 of one pixel
+    uint16_t pixel(int x, int y) const { return swap(pixels[y * w + x]); }
+
+    void setClipRect(int x, int y, int cw, int ch) override {
+        clipX0 = max(x, 0);
+        clipY0 = max(y, 0);
+        clipX1 = min(x + cw, w);
+        clipY1 = min(y + ch, h);
+        if (clipX1 < clipX0) clipX1 = clipX0;
+        if (clipY1 < clipY0) clipY1 = clipY0;
+    }
+
+    void clearClipRect() override {
+        clipX0 = 0; clipY0 = 0; clipX1 = w; clipY1 = h;
+    }
+
+    void getClipRect(int& x, int& y, int& cw, int& ch) const override {
+        x = clipX0; y = clipY0; cw = clipX1 - clipX0; ch = clipY1 - clipY0;
+    }
+
+    void fillScreen(uint16_t color) override {
+        fillRect(0, 0, w, h, color);
+    }
+
+    void fillRect(int x, int y, int rw, int rh, uint16_t color) override {
+        uint16_t c = swap(color);
+        for (int row = max(y, clipY0); row < min(y + rh, clipY1); row++) span(x, x + rw, row, c);
+    }
+
+    void drawRect(int x, int y, int rw, int rh, uint16_t color) override {
+        if (rw <= 0 || rh <= 0) return;
+        uint16_t c = swap(color);
+        span(x, x + rw, y, c);
+        span(x, x + rw, y + rh - 1, c);
+        for (int row = y + 1; row < y + rh - 1; row++) {
+            plot(x, row, c);
+            plot(x + rw - 1, row, c);
+        }
+    }
+
+    void fillRoundRect(int x, int y, int rw, int rh, int r, uint16_t color) override {
+        if (rw <= 0 || rh <= 0) return;
+        r = clampRadius(rw, rh, r);
+        uint16_t c = swap(color);
+        for (int row = 0; row < rh; row++) {
+            int inset = cornerInset(row, rh, r);
+            span(x + inset, x + rw - inset, y + row, c);
+        }
+    }
+
+    // Outline of fillRoundRect: its pixels with a 4-neighbour outside it
+    void drawRoundRect(int x, int y, int rw, int rh, int r, uint16_t color) override {
+        if (rw <= 0 || rh <= 0) return;
+        r = clampRadius(rw, rh, r);
+        uint16_t c = swap(color);
+        for (int row = 0; row < rh; row++) {
+            int inset = cornerInset(row, rh, r);
+            if (row == 0 || row == rh - 1) {
+                span(x + inset, x + rw - inset, y + row, c);
+                continue;
+            }
+            int edge = max(inset + 1, max(cornerInset(row - 1, rh, r), cornerInset(row + 1, rh, r)));
+            edge = min(edge, rw / 2 + 1);
+            span(x + inset, x + edge, y + row, c);
+            span(x + rw - edge, x + rw - inset, y + row, c);
+        }
+    }
+
+    void drawLine(int x0, int y0, int x1, int y1, uint16_t color) override {
+        uint16_t c = swap(color);
+        int dx = abs(x1 - x0), sx = x0 < x1 ? 1 : -1;
+        int dy = -abs(y1 - y0), sy = y0 < y1 ? 1 : -1;
+        int err = dx + dy;
+        for (;;) {
+            plot(x0, y0, c);
+            if (x0 == x1 && y0 == y1) break;
+            int e2 = 2 * err;
+            if (e2 >= dy) { err += dy; x0 += sx; }
+            if (e2 <= dx) { err += dx; y0 += sy; }
+        }
+    }
+
+    void pushImage(int x, int y, int iw, int ih, const uint16_t* data) override {
+        int x0 = max(x, clipX0), x1 = min(x + iw, clipX1);
+        if (x0 >= x1) return;
+        for (int row = max(y, clipY0); row < min(y + ih, clipY1); row++) {
+            memcpy(pixels + row * w + x0, data + (row - y) * iw + (x0 - x), (x1 - x0) * sizeof(uint16_t));
+        }
+    }
+
+    void setTextColor(uint16_t color) override { textColor = color; }
+    void setTextAlign(TextAlign align) override { textAlign = align; }
+    void setTextSize(int size) override { textSize = max(size, 1); }
+
+    void drawString(const char* text, int x, int y) override {
+        int len = (int)strlen(text);
+        int tw = len * Font5x7::CELL_W * textSize;
+        int th = Font5x7::CELL_H * textSize;
+        switch (textAlign) {
+            case TEXT_MIDDLE_LEFT:   y -= th / 2; break;
+            case TEXT_MIDDLE_CENTER: x -= tw / 2; y -= th / 2; break;
+            case TEXT_MIDDLE_RIGHT:  x -= tw;     y -= th / 2; break;
+            case TEXT_TOP_LEFT:
+            default:                 break;
+        }
+
+        uint16_t c = swap(textColor);
+        for (int i = 0; i < len; i++) {
+            const uint8_t* g = Font5x7::glyph(text[i]);
+            int gx = x + i * Font5x7::CELL_W * textSize;
+            for (int col = 0; col < 5; col++) {
+                for (int bit = 0; bit < 8; bit++) {
+                    if (!(g[col] & (1 << bit))) continue;
+                    int px = gx + col * textSize, py = y + bit * textSize;
+                    for (int sy = 0; sy < textSize; sy++) span(px, px + textSize, py + sy, c);
+                }
+            }
+        }
+    }
+
+    // ==========================================================================
+    // PPM (P6) dump and load
+    // ==========================================================================
+    bool writePPM(const char* path) const {
+        FILE* f = fopen(path, "wb");
+        if (!f) return false;
+        fprintf(f, "P6\n%d %d\n255\n", w, h);
+        uint8_t* row = (uint8_t*)malloc((size_t)w * 3);
+        for (int y = 0; y < h; y++) {
+            for (int x = 0; x < w; x++) {
+                uint16_t c = pixel(x, y);
+                uint8_t r = (c >> 11) & 0x1F, g = (c >> 5) & 0x3F, b = c & 0x1F;
+                row[x * 3 + 0] = (uint8_t)((r << 3) | (r >> 2));
+                row[x * 3 + 1] = (uint8_t)((g << 2) | (g >> 4));
+                row[x * 3 + 2] = (uint8_t)((b << 3) | (b >> 2));
+            }
+            fwrite(row, 3, w, f);
+        }
+        free(row);
+        return fclose(f) == 0;
+    }
+
+    // Load a PPM of exactly this size (as written by writePPM)
+    bool readPPM(const char* path) {
+        FILE* f = fopen(path, "rb");
+        if (!f) return false;
+        int fw = 0, fh = 0, maxval = 0;
+        bool ok = fscanf(f, "P6 %d %d %d", &fw, &fh, &maxval) == 3 && fgetc(f) != EOF &&
+                  fw == w && fh == h && maxval == 255;
+        uint8_t* row = (uint8_t*)malloc((size_t)w * 3);
+        for (int y = 0; ok && y < h; y++) {
+            ok = fread(row, 3, w, f) == (size_t)w;
+            for (int x = 0; ok && x < w; x++) {
+                uint16_t c = (uint16_t)(((row[x * 3] >> 3) << 11) | ((row[x * 3 + 1] >> 2) << 5) | (row[x * 3 + 2] >> 3));
+                pixels[y * w + x] = swap(c);
+            }
+        }
+        free(row);
+        fclose(f);
+        return ok;
+    }
+
+    // Pixels that differ from other (same size); bounding box of the changes
+    uint32_t countDiff(const FrameBufferTarget& other, int* bx0 = nullptr, int* by0 = nullptr,
+                       int* bx1 = nullptr, int* by1 = nullptr) const {
+        if (other.w != w || other.h != h) return (uint32_t)w * h;
+        uint32_t n = 0;
+        int x0 = w, y0 = h, x1 = -1, y1 = -1;
+        for (int y = 0; y < h; y++) {
+            for (int x = 0; x < w; x++) {
+                if (pixels[y * w + x] == other.pixels[y * w + x]) continue;
+                n++;
+                x0 = min(x0, x); y0 = min(y0, y);
+                x1 = max(x1, x); y1 = max(y1, y);
+            }
+        }
+        if (bx0) { *bx0 = x0; *by0 = y0; *bx1 = x1; *by1 = y1; }
+        return n;
+    }
+};
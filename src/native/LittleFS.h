@@ -0,0 +1,28 @@
+#pragma once
+
+// ==============================================================================
+// Host LittleFS Shim
+// "Mounts" a host directory: $PUZZLE_DATA_DIR if set, otherwise ./data
+// (the same tree `pio run --target uploadfs` flashes to the device).
+// ==============================================================================
+
+#include "FS.h"
+
+namespace fs {
+
+class LittleFSFS : public FS {
+private:
+    bool mounted = false;
+
+public:
+    bool begin(bool formatOnFail = false, const char* basePath = "/littlefs",
+               uint8_t maxOpenFiles = 10, const char* partitionLabel = "spiffs");
+    void end() { mounted = false; }
+
+    size_t totalBytes();
+    size_t usedBytes();
+};
+
+}  // namespace fs
+
+extern fs::LittleFSFS LittleFS;
@@ -0,0 +1,597 @@
+// ==============================================================================
+// Host Benchmark ([env:native])
+// Runs the engine and catalog code on Linux so hot paths can be timed and
+// profiled with real tools (perf, valgrind, gprof) instead of serial logs.
+//
+//   pio run -e native && .pio/build/native/program [iterations]
+//   PUZZLE_DATA_DIR=/path/to/data .pio/build/native/program
+//   PUZZLE_BLOB=/path/to/assets.blob (default ./assets.blob, optional)
+// ==============================================================================
+
+#include <Arduino.h>
+#include "PuzzleManager.hpp"
+#include "PuzzleAsset.hpp"
+#include "AssetBlob.hpp"
+#include "SlidingPuzzle.hpp"
+#include "PuzzleRandom.hpp"
+#include "HintEngine.hpp"
+#include "ScrambleGenerator.hpp"
+#include "TileAtlas.hpp"
+#include "ImageCache.hpp"
+#include "Animation.hpp"
+
+// Random-walk lengths for the throughput benches and the solver's test boards
+// (the game scrambles with ScrambleGenerator, see benchScrambleGenerator)
+static int shuffleMovesFor(int gridSize) {
+    return (gridSize == 3) ? 50 : (gridSize == 4) ? 150 : 300;
+}
+
+// ==============================================================================
+// Random-walk shuffle throughput per grid size
+// ==============================================================================
+static void benchShuffle(int gridSize, int iterations) {
+    SlidingPuzzle puzzle(gridSize);
+    int moves = shuffleMovesFor(gridSize);
+
+    unsigned long t0 = micros();
+    for (int i = 0; i < iterations; i++) {
+        puzzle.reset();
+        puzzle.shuffle(moves);
+    }
+    unsigned long us = micros() - t0;
+
+    Serial.printf("  shuffle %dx%d (%3d moves): %8.3f us/shuffle\n",
+                  gridSize, gridSize, moves, (double)us / iterations);
+}
+
+// ==============================================================================
+// Uniform scramble (Fisher-Yates + parity fix): cost independent of difficulty
+// ==============================================================================
+static void benchScrambleUniform(int gridSize, int iterations) {
+    SlidingPuzzle puzzle(gridSize);
+    long distance = 0;
+
+    unsigned long t0 = micros();
+    for (int i = 0; i < iterations; i++) {
+        puzzle.shuffleUniform((uint32_t)i + 1);
+        distance += puzzle.getManhattanDistance();
+    }
+    unsigned long us = micros() - t0;
+
+    Serial.printf("  uniform %dx%d:             %8.3f us/shuffle, avg Manhattan %.1f\n",
+                  gridSize, gridSize, (double)us / iterations, (double)distance / iterations);
+}
+
+// ==============================================================================
+// Player move throughput: canMove + moveTile on random neighbours of the gap
+// ==============================================================================
+static void benchMoves(int gridSize, int iterations) {
+    SlidingPuzzle puzzle(gridSize);
+    puzzle.shuffle(shuffleMovesFor(gridSize));
+
+    const int deltas[4][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
+    long applied = 0;
+
+    unsigned long t0 = micros();
+    for (int i = 0; i < iterations; i++) {
+        int empty = puzzle.getEmptyPos();
+        const int* d = deltas[random(4)];
+        int r = empty / gridSize + d[0];
+        int c = empty % gridSize + d[1];
+        if (r < 0 || r >= gridSize || c < 0 || c >= gridSize) continue;
+        if (puzzle.moveTile(r * gridSize + c)) applied++;
+    }
+    unsigned long us = micros() - t0;
+
+    Serial.printf("  moves   %dx%d: %ld moves, %8.1f ns/move\n",
+                  gridSize, gridSize, applied, us * 1000.0 / (applied ? applied : 1));
+}
+
+// ==============================================================================
+// Hint engine: IDA* (Manhattan + linear conflict) on random-walk shuffles.
+// Reports the optimal length when found and nodes/s to size HINT_BUDGET.
+// ==============================================================================
+static void benchSolver(int gridSize, int boards, uint32_t budgetMs) {
+    static HintEngine engine;
+    SolveBudget budget = {budgetMs, 0};
+    uint64_t nodes = 0, us = 0;
+    int solved = 0;
+
+    for (int i = 0; i < boards; i++) {
+        SlidingPuzzle puzzle(gridSize);
+        puzzle.shuffle(shuffleMovesFor(gridSize));
+        SolveResult r = puzzle.visit([&](const auto& b) { return engine.solve(b, budget); });
+        nodes += r.nodesExpanded;
+        us += r.elapsedUs;
+        if (r.solved) solved++;
+    }
+
+    Serial.printf("  solve %dx%d: %d/%d optimal within %u ms, %.1f ms avg, %.2f Mnodes/s\n",
+                  gridSize, gridSize, solved, boards, budgetMs,
+                  us / 1000.0 / boards, us ? nodes / (double)us : 0.0);
+}
+
+// ==============================================================================
+// Reduction solver: plan length and worst-case latency on uniform scrambles.
+// Every plan is replayed to check it really solves the board.
+// ==============================================================================
+template <int N>
+static void benchReduction(int boards) {
+    static ReductionSolver<N> reducer;
+    static MoveDir plan[ReductionSolver<N>::MAX_PATH];
+    uint64_t us = 0, length = 0, states = 0;
+    uint32_t worstUs = 0, worstStates = 0;
+    int worstLength = 0, failures = 0;
+
+    for (int i = 0; i < boards; i++) {
+        PuzzleRandom rng((uint32_t)i + 1);
+        PuzzleBoard<N> board;
+        board.scramble(rng);
+
+        int len = reducer.solve(board, plan, ReductionSolver<N>::MAX_PATH);
+        for (int m = 0; m < len; m++) board.slide(plan[m]);
+        if (len < 0 || !board.isSolved()) {
+            failures++;
+            continue;
+        }
+
+        const typename ReductionSolver<N>::Stats& s = reducer.getStats();
+        us += s.elapsedUs;
+        length += len;
+        states += s.statesExpanded;
+        if (s.elapsedUs > worstUs) worstUs = s.elapsedUs;
+        if (s.statesExpanded > worstStates) worstStates = s.statesExpanded;
+        if (len > worstLength) worstLength = len;
+    }
+
+    int ok = boards - failures;
+    Serial.printf("  reduce %dx%d: %d/%d solved, %.1f moves avg (%d worst), "
+                  "%.0f us avg (%u worst), %llu states avg (%u worst)\n",
+                  N, N, ok, boards, ok ? (double)length / ok : 0.0, worstLength,
+                  ok ? (double)us / ok : 0.0, worstUs,
+                  (unsigned long long)(ok ? states / ok : 0), worstStates);
+}
+
+// ==============================================================================
+// 3x3 lookup table: cost per hint, cross-checked against IDA* optimal lengths
+// ==============================================================================
+static void benchHintTable(const HintTable3x3& table, int boards) {
+    static PuzzleSolver<3> solver;
+    SolveBudget unlimited = {0, 0};
+    uint64_t us = 0;
+    int mismatches = 0;
+
+    for (int i = 0; i < boards; i++) {
+        PuzzleRandom rng((uint32_t)i + 1);
+        PuzzleBoard<3> board;
+        board.scramble(rng);
+
+        unsigned long t0 = micros();
+        MoveDir move = table.bestMove(board);
+        int length = table.distance(board);
+        us += micros() - t0;
+
+        PuzzleBoard<3> next = board;
+        next.slide(move);
+        SolveResult r = solver.solve(board, unlimited);
+        if (length != r.solutionLength || table.distance(next) != length - 1) mismatches++;
+    }
+
+    Serial.printf("  table 3x3: %.2f us/hint+length, %d/%d disagree with IDA*\n",
+                  (double)us / boards, mismatches, boards);
+}
+
+// ==============================================================================
+// 4x4 heuristics on a fixed board set: nodes to prove optimality with plain
+// Manhattan, Manhattan + linear conflict, and the pattern databases.
+// Boards are seeded 100-move walks, so runs are comparable across builds.
+// ==============================================================================
+static const int PDB_BENCH_BOARDS = 12;
+static const uint32_t PDB_BENCH_NODE_CAP = 200000000;
+
+static void benchPatternDatabase(PatternDatabase4x4& pdb) {
+    static PuzzleSolver<4> solver;
+    SolveBudget budget = {0, PDB_BENCH_NODE_CAP};
+    const char* names[3] = {"manhattan", "+ linear conflict", "pattern db"};
+    uint64_t nodes[3] = {};
+    uint64_t us[3] = {};
+    int solved[3] = {};
+    int disagree = 0;
+
+    for (int i = 0; i < PDB_BENCH_BOARDS; i++) {
+        PuzzleRandom rng((uint32_t)i + 1);
+        PuzzleBoard<4> board = PuzzleBoard<4>::solved();
+        MoveDir last = MOVE_NONE;
+        for (int m = 0; m < 100; m++) {
+            MoveDir d;
+            do {
+                d = board.moveAt((int)rng.below((uint32_t)board.moveCount()));
+            } while (last != MOVE_NONE && d == oppositeDir(last));
+            board.slide(d);
+            last = d;
+        }
+
+        int lengths[3];
+        for (int h = 0; h < 3; h++) {
+            solver.setLinearConflict(h >= 1);
+            solver.setPatternDatabase(h == 2 ? &pdb : nullptr);
+            SolveResult r = solver.solve(board, budget);
+            nodes[h] += r.nodesExpanded;
+            us[h] += r.elapsedUs;
+            if (r.solved) solved[h]++;
+            lengths[h] = r.solutionLength;
+        }
+        // All three are admissible, so any complete answer must match
+        for (int h = 0; h < 2; h++) {
+            if (lengths[h] >= 0 && lengths[2] >= 0 && lengths[h] != lengths[2]) disagree++;
+        }
+    }
+    solver.setLinearConflict(true);
+    solver.setPatternDatabase(nullptr);
+
+    for (int h = 0; h < 3; h++) {
+        Serial.printf("  %-18s %2d/%d solved, %12llu nodes, %9.1f ms, %6.1fx fewer nodes than manhattan\n",
+                      names[h], solved[h], PDB_BENCH_BOARDS, (unsigned long long)nodes[h],
+                      us[h] / 1000.0, nodes[h] ? (double)nodes[0] / nodes[h] : 0.0);
+    }
+    Serial.printf("  optimal lengths disagree on %d boards\n", disagree);
+}
+
+// ==============================================================================
+// Calibrated scrambles: how often the optimal length lands in the default
+// range, what verification costs in nodes (sizes ScrambleGenerator::
+// defaultSpec; node counts carry over to the device unchanged), and that a
+// seed gives the same board from a fresh generator
+// ==============================================================================
+static void benchScrambleGenerator(int gridSize, int boards) {
+    static HintEngine engine;
+    static ScrambleGenerator generator(engine);
+    ScrambleSpec spec = ScrambleGenerator::defaultSpec(gridSize);
+    SlidingPuzzle puzzle(gridSize), again(gridSize);
+    uint64_t nodes = 0, ms = 0;
+    uint32_t worstNodes = 0;
+    int inRange = 0, budgetHits = 0, mismatches = 0;
+
+    for (int i = 0; i < boards; i++) {
+        uint32_t seed = (uint32_t)i + 1;
+        int optimal = generator.generate(puzzle, seed);
+        const ScrambleGenerator::Stats& s = generator.getStats();
+        nodes += s.nodes;
+        ms += s.elapsedMs;
+        if (s.nodes > worstNodes) worstNodes = s.nodes;
+        if (s.budgetHit) budgetHits++;
+        if (optimal >= spec.minOptimal && optimal <= spec.maxOptimal) inRange++;
+
+        ScrambleGenerator fresh(engine);
+        int optimal2 = fresh.generate(again, seed);
+        bool same = optimal2 == optimal;
+        for (int p = 0; same && p < gridSize * gridSize; p++) same = again.getTile(p) == puzzle.getTile(p);
+        if (!same) {
+            Serial.printf("  SEED %u NOT REPRODUCIBLE (%d vs %d)\n", seed, optimal, optimal2);
+            mismatches++;
+        }
+    }
+
+    Serial.printf("  calibrated %dx%d (%d-%d): %d/%d in range, %d over %u nodes, %.1f ms avg, "
+                  "%llu nodes avg, %u worst, %s\n",
+                  gridSize, gridSize, spec.minOptimal, spec.maxOptimal, inRange, boards, budgetHits,
+                  (unsigned)spec.maxNodes, (double)ms / boards, (unsigned long long)(nodes / boards),
+                  worstNodes, mismatches ? "NOT deterministic" : "deterministic");
+}
+
+// With the 3x3 table, verifying a candidate expands no nodes; the budget must
+// still end a search for a range no walk reaches (3x3 optimal is at most 31)
+static void benchScrambleTableBudget(const HintTable3x3& table) {
+    static HintEngine engine;
+    engine.setTable3(&table);
+    ScrambleGenerator generator(engine);
+    SlidingPuzzle puzzle(3);
+    ScrambleSpec unreachable = {32, 34, 0, 5000};
+
+    int optimal = generator.generate(puzzle, 1, unreachable);
+    const ScrambleGenerator::Stats& s = generator.getStats();
+    Serial.printf("  calibrated 3x3 (32-34, table): stopped after %u candidates, best %d, %s\n",
+                  (unsigned)s.candidates, optimal,
+                  s.budgetHit && s.candidates <= unreachable.maxNodes ? "bounded" : "NOT BOUNDED");
+}
+
+// ==============================================================================
+// Asset read throughput (same path loadPuzzleImage() takes)
+// ==============================================================================
+static void benchImageLoad(const PuzzleManager& manager) {
+    static uint16_t image[480 * 480];
+    AssetReader reader;
+    size_t total = 0;
+    uint32_t readUs = 0, decodeUs = 0;
+    int files = 0;
+
+    unsigned long t0 = micros();
+    for (int d = 0; d < 3; d++) {
+        for (int i = 0; i < manager.getPuzzleCount(d); i++) {
+            PuzzleInfo info = manager.getPuzzle(d, i);
+            if (!reader.load(LittleFS, info.filename, image, 480, 480, info.offset)) continue;
+            if (reader.getStats().crc32 != info.crc32) Serial.printf("  CRC MISMATCH: %s\n", info.filename);
+            total += reader.getStats().fileBytes;
+            readUs += reader.getStats().readUs;
+            decodeUs += reader.getStats().decodeUs;
+            files++;
+        }
+    }
+    unsigned long us = micros() - t0;
+
+    Serial.printf("  image load: %d files, %u bytes (%.1f%% of raw), %.2f ms/file (read %.2f, decode %.2f)\n",
+                  files, (unsigned)total, files ? 100.0 * total / (files * 460800.0) : 0.0,
+                  files ? us / 1000.0 / files : 0.0,
+                  files ? readUs / 1000.0 / files : 0.0, files ? decodeUs / 1000.0 / files : 0.0);
+}
+
+// ==============================================================================
+// Tile atlas build (once per puzzle load): box vs nearest filter, per grid size
+// ==============================================================================
+static void benchTileAtlas(const PuzzleManager& manager) {
+    static uint16_t image[480 * 480];
+    if (manager.getPuzzleCount(0) == 0) return;
+    PuzzleInfo easy = manager.getPuzzle(0, 0);
+    AssetReader reader;
+    if (!reader.load(LittleFS, easy.filename, image, 480, 480, easy.offset)) return;
+
+    const int gameArea = 390;       // GAME_AREA_SIZE in main.cpp
+    for (int n = 3; n <= 5; n++) {
+        for (int f = 0; f < 2; f++) {
+            AtlasFilter filter = f ? ATLAS_BOX : ATLAS_NEAREST;
+            TileAtlas atlas;
+            unsigned long t0 = micros();
+            bool ok = atlas.build(image, n, gameArea / n, filter, 0x4208);
+            Serial.printf("  atlas %dx%d %-7s: %s, %.2f ms\n", n, n, f ? "box" : "nearest",
+                          ok ? "ok" : "FAILED", (micros() - t0) / 1000.0);
+        }
+    }
+}
+
+// ==============================================================================
+// Image cache: prefetch in 4 ms slices (as loop() runs it on the select
+// screen), then a play session's picks: hits skip flash, misses load
+// ==============================================================================
+static void benchImageCache(const PuzzleManager& manager) {
+    if (manager.getPuzzleCount(0) < 2 || manager.getPuzzleCount(1) < 3) return;
+    ImageCache cache(LittleFS, ATLAS_BOX, 0x4208);
+    const int gameArea = 390;       // GAME_AREA_SIZE in main.cpp
+
+    // Select screen for Easy: its first two puzzles
+    for (int i = 0; i < 2; i++) cache.prefetch(manager.getPuzzle(0, i), gameArea / 3);
+    unsigned long t0 = micros(), longest = 0;
+    int slices = 0;
+    bool more = true;
+    while (more) {
+        unsigned long s0 = micros();
+        more = cache.step(4000);
+        longest = max(longest, micros() - s0);
+        slices++;
+    }
+    unsigned long prefetchUs = micros() - t0;
+
+    // Pick Easy 0, Play Again, Back to Easy 1, then Medium 0-2, then Easy 0
+    struct Pick { int d, i; } picks[] = {{0, 0}, {0, 0}, {0, 1}, {1, 0}, {1, 1}, {1, 2}, {0, 0}};
+    unsigned long hitUs = 0, missUs = 0;
+    for (const Pick& p : picks) {
+        PuzzleInfo info = manager.getPuzzle(p.d, p.i);
+        uint32_t hits = cache.getStats().hits;
+        t0 = micros();
+        bool ok = cache.acquire(info, gameArea / info.gridSize) != nullptr;
+        unsigned long us = micros() - t0;
+        if (!ok) Serial.printf("  LOAD FAILED: %s\n", info.filename);
+        if (cache.getStats().hits > hits) hitUs += us;
+        else missUs += us;
+    }
+    const ImageCache::Stats& st = cache.getStats();
+    Serial.printf("  image cache: prefetch %u puzzles in %d slices (%.1f ms, longest slice %.2f ms)\n",
+                  (unsigned)st.prefetched, slices, prefetchUs / 1000.0, longest / 1000.0);
+    Serial.printf("  image cache: %u hits (%.3f ms avg), %u misses (%.2f ms avg), %u evictions\n",
+                  (unsigned)st.hits, st.hits ? hitUs / 1000.0 / st.hits : 0.0,
+                  (unsigned)st.misses, st.misses ? missUs / 1000.0 / st.misses : 0.0, (unsigned)st.evictions);
+}
+
+// ==============================================================================
+// Streaming start (cache miss): when the first tile is drawable vs when the
+// whole board is, per grid size. Before streaming, nothing was drawn until the
+// whole load finished.
+// ==============================================================================
+struct StreamTimes {
+    unsigned long startUs;
+    unsigned long firstUs;
+    int cells;
+};
+
+static void onStreamedCell(void* context, int, const TileAtlas&) {
+    StreamTimes* t = (StreamTimes*)context;
+    if (!t->cells++) t->firstUs = micros() - t->startUs;
+}
+
+static void benchStreamingLoad(const PuzzleManager& manager) {
+    const int gameArea = 390;       // GAME_AREA_SIZE in main.cpp
+    for (int d = 0; d < 3; d++) {
+        if (!manager.getPuzzleCount(d)) continue;
+        PuzzleInfo info = manager.getPuzzle(d, 0);
+        ImageCache cache(LittleFS, ATLAS_BOX, 0x4208);
+        StreamTimes t = {micros(), 0, 0};
+        bool ok = cache.acquire(info, gameArea / info.gridSize, onStreamedCell, &t) != nullptr;
+        unsigned long totalUs = micros() - t.startUs;
+        Serial.printf("  streaming %dx%d: first tile %.2f ms, all %d tiles %.2f ms%s\n",
+                      info.gridSize, info.gridSize, t.firstUs / 1000.0, t.cells, totalUs / 1000.0,
+                      ok ? "" : " (LOAD FAILED)");
+    }
+}
+
+// ==============================================================================
+// Puzzle switch from the asset blob (map + attach, as loadPuzzleImage() does)
+// vs the file path (read + decode + atlas build)
+// ==============================================================================
+static void benchBlobSwitch(const PuzzleManager& manager) {
+    static AssetBlob blob;
+    if (!blob.begin(manager.getCatalogCrc(), manager.getTotalCount())) {
+        Serial.println("  blob: none for this catalog (build_blob), skipped");
+        return;
+    }
+    static uint16_t image[480 * 480];
+    AssetReader reader;
+    TileAtlas atlas;
+    unsigned long blobUs = 0, fileUs = 0;
+    uint32_t sum = 0;
+    int n = manager.getTotalCount();
+
+    for (int i = 0; i < n; i++) {
+        PuzzleInfo info = manager.getRecord(i);
+        int tileSize = 390 / info.gridSize;     // GAME_AREA_SIZE in main.cpp
+
+        unsigned long t0 = micros();
+        AssetBlob::View v;
+        if (!blob.map(i, v)) continue;
+        atlas.attach(v.tiles, info.gridSize, tileSize);
+        blobUs += micros() - t0;
+        sum += atlas.tile(info.gridSize * info.gridSize)[0];  // Touch the last tile
+
+        t0 = micros();
+        if (reader.load(LittleFS, info.filename, image, 480, 480, info.offset)) {
+            atlas.build(image, info.gridSize, tileSize, ATLAS_BOX, 0x4208);
+        }
+        fileUs += micros() - t0;
+    }
+    atlas.release();
+    Serial.printf("  puzzle switch: blob %.3f ms, file %.2f ms (avg of %d; PSRAM 0 vs ~760 KB) [%u]\n",
+                  blobUs / 1000.0 / n, fileUs / 1000.0 / n, n, (unsigned)(sum & 1));
+}
+
+// ==============================================================================
+// Line moves: moveLine() must leave the same board, move count and Manhattan
+// distance as the equivalent run of single moveTile() calls
+// ==============================================================================
+static void benchLineMoves(int taps) {
+    for (int n = 3; n <= 5; n++) {
+        SlidingPuzzle line(n), single(n);
+        line.shuffleUniform(1000 + n);
+        single.shuffleUniform(1000 + n);
+        PuzzleRandom rng(77 + n);
+        int lines = 0, mismatches = 0;
+
+        for (int i = 0; i < taps; i++) {
+            int tilePos = (int)rng.below((uint32_t)(n * n));
+            int count = line.lineLength(tilePos);
+            int moved = line.moveLine(tilePos);
+            if (count) lines++;
+
+            int step = count ? (tilePos - single.getEmptyPos()) / count : 0;
+            bool ok = moved == count;
+            for (int k = 0; k < count; k++) ok = single.moveTile(single.getEmptyPos() + step) && ok;
+
+            ok = ok && line.getMoveCount() == single.getMoveCount() &&
+                 line.getManhattanDistance() == single.getManhattanDistance();
+            for (int p = 0; ok && p < n * n; p++) ok = line.getTile(p) == single.getTile(p);
+            if (!ok) {
+                if (mismatches++ < 5) {
+                    Serial.printf("  moveLine %dx%d: MISMATCH at tap %d (pos %d, %d tiles)\n",
+                                  n, n, i, tilePos, count);
+                }
+                single = line;      // Resync so one bug is not reported for every later tap
+            }
+        }
+        Serial.printf("  moveLine %dx%d: %d taps (%d moved a run), %d mismatches\n",
+                      n, n, taps, lines, mismatches);
+    }
+}
+
+// ==============================================================================
+// Slide animation at 60 fps: frames and pixels redrawn per frame, full path
+// clear (before) vs uncovered strip + tile (now)
+// ==============================================================================
+static void benchSlideDamage() {
+    const int gameArea = 390;       // GAME_AREA_SIZE in main.cpp
+    FramePacer pacer(60);
+    for (int n = 3; n <= 5; n++) {
+        int tileSize = gameArea / n;
+        SlideAnimation slide = {0, 0, tileSize, 0, 180000, EASE_OUT_CUBIC};
+        int prevX = 0, prevY = 0;
+        uint32_t frames = 0, pathPx = 0, stripPx = 0;
+
+        // Frames presented exactly on their ticks
+        pacer.start(0);
+        for (uint32_t now = pacer.getPeriodUs(); ; now += pacer.getPeriodUs()) {
+            uint32_t t = pacer.beginFrame(now);
+            if (slide.isDone(t)) break;
+            int x, y, sx, sy, sw, sh;
+            slide.position(t, x, y);
+            if (SlideAnimation::uncovered(prevX, prevY, x, y, tileSize, tileSize, sx, sy, sw, sh)) {
+                stripPx += sw * sh;
+            }
+            stripPx += tileSize * tileSize;
+            pathPx += 2 * tileSize * tileSize + tileSize * tileSize;    // Path clear + tile
+            prevX = x;
+            prevY = y;
+            frames++;
+        }
+        Serial.printf("  slide %dx%d: %u frames, %u px/frame (was %u), final step %d px\n", n, n,
+                      (unsigned)frames, (unsigned)(stripPx / frames), (unsigned)(pathPx / frames),
+                      tileSize - prevX);
+    }
+
+    // Easing curves must be monotonic and exact at the ends
+    for (int c = EASE_LINEAR; c <= EASE_IN_OUT_CUBIC; c++) {
+        int32_t prev = 0;
+        bool ok = Easing::apply((EaseCurve)c, 0) == 0 && Easing::apply((EaseCurve)c, Easing::ONE) == Easing::ONE;
+        for (int32_t t = 0; t <= Easing::ONE; t += 64) {
+            int32_t e = Easing::apply((EaseCurve)c, t);
+            if (e < prev) ok = false;
+            prev = e;
+        }
+        if (!ok) Serial.printf("  easing curve %d: NOT MONOTONIC\n", c);
+    }
+}
+
+int main(int argc, char** argv) {
+    int iterations = argc > 1 ? atoi(argv[1]) : 10000;
+    if (iterations <= 0) iterations = 10000;
+
+    Serial.println("========================================");
+    Serial.println("  Sliding Puzzle - host benchmark");
+    Serial.println("========================================");
+
+    PuzzleManager manager;
+    unsigned long t0 = micros();
+    bool catalogOk = manager.init();
+    Serial.printf("PuzzleManager::init: %.3f ms (%s)\n\n",
+                  (micros() - t0) / 1000.0, catalogOk ? "ok" : "incomplete");
+
+    Serial.printf("Engine (%d iterations):\n", iterations);
+    for (int n = 3; n <= 5; n++) benchShuffle(n, iterations);
+    for (int n = 3; n <= 5; n++) benchScrambleUniform(n, iterations);
+    for (int n = 3; n <= 5; n++) benchMoves(n, iterations * 100);
+
+    Serial.println("\nHint engine:");
+    benchSolver(3, 100, 1000);
+    benchSolver(4, 10, 1000);
+    benchSolver(5, 3, 1000);
+    benchReduction<4>(1000);
+    benchReduction<5>(1000);
+
+    static HintTable3x3 table3;
+    if (catalogOk && table3.load(LittleFS)) benchHintTable(table3, 1000);
+
+    static PatternDatabase4x4 pdb4;
+    if (catalogOk && pdb4.load(LittleFS, PDB_IN_PSRAM)) benchPatternDatabase(pdb4);
+    for (int n = 3; n <= 5; n++) benchScrambleGenerator(n, 200);
+    if (table3.isLoaded()) benchScrambleTableBudget(table3);
+
+    Serial.println("\nRendering:");
+    benchSlideDamage();
+    benchLineMoves(20000);
+
+    if (catalogOk) {
+        Serial.println("\nAssets:");
+        benchImageLoad(manager);
+        benchTileAtlas(manager);
+        benchImageCache(manager);
+        benchStreamingLoad(manager);
+        benchBlobSwitch(manager);
+    }
+
+    return 0;
+}
@@ -0,0 +1,290 @@
+// ==============================================================================
+// batch_solve ([env:batch_solve])
+// Solves a file of boards optimally across all cores and reports per-board
+// optimal length, nodes and wall time, plus aggregate nodes/s per core. Used to
+// validate solver changes and to precompute optimal lengths for scramble seeds.
+//
+//   batch_solve [options] boards.txt     (one board per line, "-" = stdin)
+//   batch_solve [options] --seeds <size> <first> <count>
+//
+//   --threads <n>      worker threads (default: all cores)
+//   --max-nodes <n>    give up on a board after n nodes (default: unlimited)
+//   --pdb <prefix>     4x4 pattern databases, e.g. data/solver/pdb4_
+//
+// A board line is 9, 16 or 25 numbers in reading order (0 = empty), separated
+// by spaces or commas; '#' starts a comment and blank lines are skipped.
+// --seeds solves the uniform scrambles SlidingPuzzle::shuffleUniform(seed).
+// Results go to stdout as CSV; the summary and any log lines go to stderr.
+//
+// Boards are dealt round-robin to per-thread deques. Each worker pops from the
+// back of its own deque and, when empty, steals from the front of the others,
+// so a few very hard boards do not leave the remaining cores idle.
+// ==============================================================================
+
+#include <Arduino.h>
+#include <LittleFS.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "SlidingPuzzle.hpp"
+#include "HintEngine.hpp"
+#include "PatternDatabase4x4.hpp"
+
+struct Job {
+    int line;                   // Source line (or seed index)
+    int gridSize;
+    uint8_t tiles[25];
+};
+
+struct JobResult {
+    bool valid = false;
+    bool solvable = false;
+    bool solved = false;
+    int length = -1;
+    int lowerBound = 0;
+    uint64_t nodes = 0;
+    uint64_t us = 0;
+    int worker = -1;
+};
+
+// ==============================================================================
+// Work-stealing pool over a fixed set of jobs (no job creates new ones)
+// ==============================================================================
+class WorkStealingPool {
+private:
+    struct Queue {
+        std::mutex lock;
+        std::deque<int> jobs;
+    };
+    std::vector<Queue> queues;
+
+public:
+    explicit WorkStealingPool(int workers) : queues(workers) {}
+
+    void deal(int jobCount) {
+        for (int j = 0; j < jobCount; j++) queues[j % queues.size()].jobs.push_back(j);
+    }
+
+    // Own deque from the back, then steal from the front of the others
+    bool next(int self, int& job, uint32_t& steals) {
+        {
+            std::lock_guard<std::mutex> guard(queues[self].lock);
+            if (!queues[self].jobs.empty()) {
+                job = queues[self].jobs.back();
+                queues[self].jobs.pop_back();
+                return true;
+            }
+        }
+        int n = (int)queues.size();
+        for (int i = 1; i < n; i++) {
+            Queue& victim = queues[(self + i) % n];
+            std::lock_guard<std::mutex> guard(victim.lock);
+            if (!victim.jobs.empty()) {
+                job = victim.jobs.front();
+                victim.jobs.pop_front();
+                steals++;
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+struct WorkerStats {
+    uint64_t nodes = 0;
+    uint64_t busyUs = 0;
+    uint32_t boards = 0;
+    uint32_t steals = 0;
+};
+
+static bool parseBoard(const char* text, Job& job) {
+    int values[26];
+    int count = 0;
+    const char* p = text;
+    while (*p) {
+        while (*p == ' ' || *p == '\t' || *p == ',') p++;
+        if (!*p || *p == '\n' || *p == '\r' || *p == '#') break;
+        char* end;
+        long v = strtol(p, &end, 10);
+        if (end == p || count == 26) return false;
+        values[count++] = (int)v;
+        p = end;
+    }
+
+    int n = (count == 9) ? 3 : (count == 16) ? 4 : (count == 25) ? 5 : 0;
+    if (n == 0) return false;
+
+    // Must be a permutation of 0..count-1
+    uint32_t seen = 0;
+    for (int i = 0; i < count; i++) {
+        if (values[i] < 0 || values[i] >= count || (seen & (1u << values[i]))) return false;
+        seen |= 1u << values[i];
+        job.tiles[i] = (uint8_t)values[i];
+    }
+    job.gridSize = n;
+    return true;
+}
+
+static void usage() {
+    fprintf(stderr,
+            "usage: batch_solve [--threads n] [--max-nodes n] [--pdb prefix] boards.txt\n"
+            "       batch_solve [options] --seeds <size> <first> <count>\n");
+}
+
+int main(int argc, char** argv) {
+    Serial.setStream(stderr);       // Library logs (PDB load) stay out of the CSV
+    int threads = (int)std::thread::hardware_concurrency();
+    uint64_t maxNodes = 0;
+    const char* pdbPrefix = nullptr;
+    const char* inputPath = nullptr;
+    int seedSize = 0;
+    uint32_t seedFirst = 0, seedCount = 0;
+
+    for (int a = 1; a < argc; a++) {
+        if (!strcmp(argv[a], "--threads") && a + 1 < argc) {
+            threads = atoi(argv[++a]);
+        } else if (!strcmp(argv[a], "--max-nodes") && a + 1 < argc) {
+            maxNodes = strtoull(argv[++a], nullptr, 10);
+        } else if (!strcmp(argv[a], "--pdb") && a + 1 < argc) {
+            pdbPrefix = argv[++a];
+        } else if (!strcmp(argv[a], "--seeds") && a + 3 < argc) {
+            seedSize = atoi(argv[++a]);
+            seedFirst = (uint32_t)strtoul(argv[++a], nullptr, 10);
+            seedCount = (uint32_t)strtoul(argv[++a], nullptr, 10);
+        } else if (argv[a][0] != '-' || !strcmp(argv[a], "-")) {
+            inputPath = argv[a];
+        } else {
+            usage();
+            return 1;
+        }
+    }
+    if (threads < 1) threads = 1;
+    if (!inputPath && seedSize == 0) {
+        usage();
+        return 1;
+    }
+
+    // ------------------------------------------------------------------ input
+    std::vector<Job> jobs;
+    if (seedSize) {
+        if (seedSize < 3 || seedSize > 5) {
+            fprintf(stderr, "--seeds size must be 3, 4 or 5\n");
+            return 1;
+        }
+        for (uint32_t i = 0; i < seedCount; i++) {
+            SlidingPuzzle puzzle(seedSize);
+            puzzle.shuffleUniform(seedFirst + i);
+            Job job = {(int)(seedFirst + i), seedSize, {}};
+            for (int p = 0; p < seedSize * seedSize; p++) job.tiles[p] = (uint8_t)puzzle.getTile(p);
+            jobs.push_back(job);
+        }
+    } else {
+        FILE* in = strcmp(inputPath, "-") ? fopen(inputPath, "r") : stdin;
+        if (!in) {
+            fprintf(stderr, "cannot open %s\n", inputPath);
+            return 1;
+        }
+        char line[512];
+        int lineNo = 0;
+        while (fgets(line, sizeof(line), in)) {
+            lineNo++;
+            const char* p = line;
+            while (*p == ' ' || *p == '\t') p++;
+            if (*p == '#' || *p == '\n' || *p == '\r' || *p == 0) continue;
+            Job job = {lineNo, 0, {}};
+            if (!parseBoard(p, job)) {
+                fprintf(stderr, "line %d: expected 9, 16 or 25 distinct numbers\n", lineNo);
+                if (in != stdin) fclose(in);
+                return 1;
+            }
+            jobs.push_back(job);
+        }
+        if (in != stdin) fclose(in);
+    }
+
+    // Pattern databases are read-only once loaded into memory: shared by all
+    static PatternDatabase4x4 pdb;
+    if (pdbPrefix) {
+        LittleFS.setRoot(pdbPrefix[0] == '/' ? "" : ".");     // Prefix is a host path
+        if (!pdb.load(LittleFS, PDB_IN_PSRAM, pdbPrefix)) return 1;
+    }
+
+    // ------------------------------------------------------------------ solve
+    std::vector<JobResult> results(jobs.size());
+    std::vector<WorkerStats> stats(threads);
+    WorkStealingPool pool(threads);
+    pool.deal((int)jobs.size());
+    SolveBudget budget = {0, maxNodes};
+
+    auto worker = [&](int self) {
+        HintEngine* engine = new HintEngine();      // Solver buffers are large for a stack
+        if (pdbPrefix) engine->setPatternDatabase(&pdb);
+        WorkerStats& ws = stats[self];
+        int j;
+        while (pool.next(self, j, ws.steals)) {
+            SlidingPuzzle puzzle(jobs[j].gridSize);
+            puzzle.loadScramble(jobs[j].tiles, 0, -1);
+            JobResult& r = results[j];
+            r.valid = true;
+            r.worker = self;
+            r.solvable = puzzle.isSolvable();
+            if (!r.solvable) continue;
+
+            SolveResult s = puzzle.visit([&](const auto& b) { return engine->solve(b, budget); });
+            r.solved = s.solved;
+            r.length = s.solutionLength;
+            r.lowerBound = s.lowerBound;
+            r.nodes = s.nodesExpanded;
+            r.us = s.elapsedUs;
+            ws.nodes += s.nodesExpanded;
+            ws.busyUs += s.elapsedUs;
+            ws.boards++;
+        }
+        delete engine;
+    };
+
+    unsigned long t0 = micros();
+    std::vector<std::thread> poolThreads;
+    for (int t = 1; t < threads; t++) poolThreads.emplace_back(worker, t);
+    worker(0);
+    for (auto& th : poolThreads) th.join();
+    double wallSec = (micros() - t0) / 1e6;
+
+    // ----------------------------------------------------------------- report
+    printf("# line,size,optimal,lower_bound,nodes,ms,status\n");
+    int solved = 0, unsolvable = 0, gaveUp = 0;
+    for (size_t j = 0; j < jobs.size(); j++) {
+        const JobResult& r = results[j];
+        const char* status = !r.solvable ? "unsolvable" : r.solved ? "optimal" : "budget";
+        if (!r.solvable) unsolvable++;
+        else if (r.solved) solved++;
+        else gaveUp++;
+        printf("%d,%d,%d,%d,%llu,%.3f,%s\n", jobs[j].line, jobs[j].gridSize, r.length,
+               r.lowerBound, (unsigned long long)r.nodes, r.us / 1000.0, status);
+    }
+
+    uint64_t nodes = 0, busyUs = 0;
+    uint32_t steals = 0;
+    for (const WorkerStats& ws : stats) {
+        nodes += ws.nodes;
+        busyUs += ws.busyUs;
+        steals += ws.steals;
+    }
+    fprintf(stderr, "%zu boards: %d optimal, %d over budget, %d unsolvable\n",
+            jobs.size(), solved, gaveUp, unsolvable);
+    fprintf(stderr, "%d threads, %.3f s wall, %llu nodes, %.2f Mnodes/s total, "
+                    "%.2f Mnodes/s per core, %u steals\n",
+            threads, wallSec, (unsigned long long)nodes,
+            wallSec > 0 ? nodes / wallSec / 1e6 : 0.0,
+            busyUs ? nodes / (double)busyUs : 0.0, steals);
+    for (int t = 0; t < threads; t++) {
+        fprintf(stderr, "  worker %2d: %4u boards, %12llu nodes, %8.1f ms busy\n", t,
+                stats[t].boards, (unsigned long long)stats[t].nodes, stats[t].busyUs / 1000.0);
+    }
+    return gaveUp ? 2 : 0;
+}
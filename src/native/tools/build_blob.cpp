@@ -0,0 +1,122 @@
+// ==============================================================================
+// build_blob ([env:build_blob])
+// Builds the asset blob (src/AssetBlob.hpp) for the "assets" flash partition:
+// for every catalog record, the puzzle's tiles scaled to the board's tile size
+// exactly as TileAtlas builds them at run time (box filter, grid border) and
+// the win preview scaled as the win screen scales it. The result is mapped
+// back through the esp_partition shim and checked against what was built.
+//
+//   build_blob [--data dir] [--out file]
+//
+//   --data dir    filesystem image root with catalog.bin (default ./data)
+//   --out file    output (default ./assets.blob)
+//
+// Flash it at the "assets" offset in partitions_blob.csv (see README).
+// ==============================================================================
+
+#include <Arduino.h>
+#include <FS.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "AssetBlob.hpp"
+#include "GameScreens.hpp"
+#include "PuzzleAsset.hpp"
+#include "PuzzleManager.hpp"
+#include "TileAtlas.hpp"
+
+static const int IMAGE_SIZE = 480;
+
+int main(int argc, char** argv) {
+    std::string dataDir = "data";
+    std::string outPath = "assets.blob";
+    bool usage = false;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--data") && i + 1 < argc) dataDir = argv[++i];
+        else if (!strcmp(argv[i], "--out") && i + 1 < argc) outPath = argv[++i];
+        else usage = true;
+    }
+    if (usage) {
+        fprintf(stderr, "usage: %s [--data dir] [--out file]\n", argv[0]);
+        return 2;
+    }
+
+    fs::FS data(dataDir);
+    PuzzleManager catalog;
+    if (!catalog.load(data)) {
+        printf("no catalog in %s\n", dataDir.c_str());
+        return 1;
+    }
+
+    AssetReader reader;
+    TileAtlas atlas;
+    std::vector<uint16_t> image(IMAGE_SIZE * IMAGE_SIZE);
+    uint16_t map[AssetBlob::PREVIEW_SIZE];
+    PixelKernels::buildScaleMap(map, IMAGE_SIZE, AssetBlob::PREVIEW_SIZE);
+    std::vector<AssetBlob::Source> sources;
+    int failures = 0;
+
+    for (int i = 0; i < catalog.getTotalCount(); i++) {
+        PuzzleInfo info = catalog.getRecord(i);
+        int tileSize = GAME_AREA_SIZE / info.gridSize;
+        if (!reader.load(data, info.filename, image.data(), IMAGE_SIZE, IMAGE_SIZE, info.offset) ||
+            reader.getStats().crc32 != info.crc32) {
+            printf("  %2d %s does not load (or fails its catalog CRC)\n", i, info.filename);
+            failures++;
+            continue;
+        }
+        if (!atlas.build(image.data(), info.gridSize, tileSize, ATLAS_BOX, COL_GRID_LINE)) {
+            printf("  %2d %s: cannot build tiles\n", i, info.filename);
+            failures++;
+            continue;
+        }
+
+        AssetBlob::Source s;
+        s.gridSize = info.gridSize;
+        s.tileSize = tileSize;
+        s.previewSize = AssetBlob::PREVIEW_SIZE;
+        const uint16_t* tiles = atlas.tile(1);
+        s.tiles.assign(tiles, tiles + (size_t)info.gridSize * info.gridSize * tileSize * tileSize);
+        s.preview.resize(AssetBlob::PREVIEW_SIZE * AssetBlob::PREVIEW_SIZE);
+        for (int y = 0; y < AssetBlob::PREVIEW_SIZE; y++) {
+            PixelKernels::scaleRow(&s.preview[y * AssetBlob::PREVIEW_SIZE], image.data() + map[y] * IMAGE_SIZE,
+                                   map, AssetBlob::PREVIEW_SIZE);
+        }
+        printf("  %2d %dx%d  %3d px tiles  %-36s %s\n", i, info.gridSize, info.gridSize, tileSize,
+               info.filename, info.displayName);
+        sources.push_back(std::move(s));
+    }
+    if (failures) {
+        printf("%d failure(s), blob not written\n", failures);
+        return 1;
+    }
+
+    std::vector<uint8_t> blob = AssetBlob::build(sources, catalog.getCatalogCrc());
+    FILE* out = blob.empty() ? nullptr : fopen(outPath.c_str(), "wb");
+    bool written = out && fwrite(blob.data(), 1, blob.size(), out) == blob.size();
+    if (out) written = fclose(out) == 0 && written;
+    if (!written) {
+        printf("cannot write %s\n", outPath.c_str());
+        return 1;
+    }
+
+    // Map it back the way the firmware does and compare every entry
+    setenv("PUZZLE_BLOB", outPath.c_str(), 1);
+    AssetBlob check;
+    bool ok = check.begin(catalog.getCatalogCrc(), catalog.getTotalCount());
+    for (int i = 0; ok && i < (int)sources.size(); i++) {
+        AssetBlob::View v;
+        const AssetBlob::Source& s = sources[i];
+        ok = check.verify(i) && check.map(i, v) && v.gridSize == s.gridSize && v.tileSize == s.tileSize &&
+             memcmp(v.tiles, s.tiles.data(), s.tiles.size() * sizeof(uint16_t)) == 0 &&
+             memcmp(v.preview, s.preview.data(), s.preview.size() * sizeof(uint16_t)) == 0;
+        if (!ok) printf("entry %d does not map back\n", i);
+    }
+    if (!ok) return 1;
+
+    printf("%s: %d puzzles, %u bytes (%.2f MB), catalog crc %08x\n", outPath.c_str(), (int)sources.size(),
+           (unsigned)blob.size(), blob.size() / 1048576.0, (unsigned)catalog.getCatalogCrc());
+    return 0;
+}
@@ -0,0 +1,133 @@
+// ==============================================================================
+// build_catalog ([env:build_catalog])
+// Builds the binary puzzle catalog (src/PuzzleCatalog.hpp) from a CSV list:
+//
+//   difficulty,grid,path,name        (one puzzle per line, # comments)
+//
+// Each asset is read from the data directory to record its size and CRC-32
+// and must decode as a 480x480 image (.pza or raw .rgb565), so a catalog never
+// names a file the firmware cannot load.
+//
+//   build_catalog [--data dir] [--out file] tools/puzzles.csv
+//
+//   --data dir    filesystem image root (default ./data)
+//   --out file    output (default <data>/catalog.bin)
+// ==============================================================================
+
+#include <Arduino.h>
+#include <FS.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "PuzzleAsset.hpp"
+#include "PuzzleCatalog.hpp"
+#include "PuzzleManager.hpp"
+
+static const int IMAGE_SIZE = 480;
+
+// "a,b,c,rest of line" -> fields (the last one keeps its commas)
+static std::vector<std::string> splitFields(const std::string& line, int count) {
+    std::vector<std::string> fields;
+    size_t start = 0;
+    while ((int)fields.size() < count - 1) {
+        size_t comma = line.find(',', start);
+        if (comma == std::string::npos) break;
+        fields.push_back(line.substr(start, comma - start));
+        start = comma + 1;
+    }
+    fields.push_back(line.substr(start));
+    return fields;
+}
+
+int main(int argc, char** argv) {
+    std::string dataDir = "data";
+    std::string outPath;
+    const char* listPath = nullptr;
+    bool usage = false;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--data") && i + 1 < argc) dataDir = argv[++i];
+        else if (!strcmp(argv[i], "--out") && i + 1 < argc) outPath = argv[++i];
+        else if (argv[i][0] != '-' && !listPath) listPath = argv[i];
+        else usage = true;
+    }
+    if (usage || !listPath) {
+        fprintf(stderr, "usage: %s [--data dir] [--out file] puzzles.csv\n", argv[0]);
+        return 2;
+    }
+    if (outPath.empty()) outPath = dataDir + PuzzleCatalog::DEFAULT_PATH;
+
+    FILE* list = fopen(listPath, "r");
+    if (!list) {
+        fprintf(stderr, "cannot open %s\n", listPath);
+        return 1;
+    }
+
+    fs::FS data(dataDir);
+    AssetReader reader;
+    std::vector<uint16_t> image(IMAGE_SIZE * IMAGE_SIZE);
+    std::vector<PuzzleCatalog::Source> sources;
+    int failures = 0, lineNo = 0;
+    char buf[512];
+
+    while (fgets(buf, sizeof(buf), list)) {
+        lineNo++;
+        std::string line = buf;
+        while (!line.empty() && (line.back() == '\n' || line.back() == '\r')) line.pop_back();
+        if (line.empty() || line[0] == '#') continue;
+
+        std::vector<std::string> f = splitFields(line, 4);
+        int difficulty = f.size() == 4 ? atoi(f[0].c_str()) : -1;
+        int grid = f.size() == 4 ? atoi(f[1].c_str()) : 0;
+        if (difficulty < 0 || difficulty >= PuzzleCatalog::DIFFICULTIES || grid < 3 || grid > 5 ||
+            f[2].empty() || f[2][0] != '/' || f[3].empty()) {
+            printf("  %s:%d: expected difficulty,grid,/path,name\n", listPath, lineNo);
+            failures++;
+            continue;
+        }
+
+        PuzzleCatalog::Source s = {f[2], f[3], grid, difficulty, 0, 0, 0};
+        if (!reader.load(data, s.path.c_str(), image.data(), IMAGE_SIZE, IMAGE_SIZE)) {
+            printf("  %s:%d: %s does not load\n", listPath, lineNo, s.path.c_str());
+            failures++;
+            continue;
+        }
+        s.size = reader.getStats().fileBytes;
+        s.crc32 = reader.getStats().crc32;
+        printf("  %d %dx%d  %-36s %7u bytes  crc %08x  %s\n", difficulty, grid, grid, s.path.c_str(),
+               (unsigned)s.size, (unsigned)s.crc32, s.name.c_str());
+        sources.push_back(s);
+    }
+    fclose(list);
+    if (failures) {
+        printf("%d failure(s), catalog not written\n", failures);
+        return 1;
+    }
+
+    std::vector<uint8_t> catalog = PuzzleCatalog::build(sources);
+    if (catalog.empty()) {
+        printf("catalog too large (string pool over 64 KB)\n");
+        return 1;
+    }
+
+    // Must load back exactly as the firmware loads it
+    PuzzleManager check;
+    uint8_t* copy = (uint8_t*)malloc(catalog.size());
+    memcpy(copy, catalog.data(), catalog.size());
+    if (!check.adopt(copy, catalog.size()) || check.getTotalCount() != (int)sources.size()) {
+        printf("catalog does not load back\n");
+        return 1;
+    }
+
+    FILE* out = fopen(outPath.c_str(), "wb");
+    bool written = out && fwrite(catalog.data(), 1, catalog.size(), out) == catalog.size();
+    if (out) written = fclose(out) == 0 && written;
+    if (!written) {
+        printf("cannot write %s\n", outPath.c_str());
+        return 1;
+    }
+    printf("%s: %d puzzles (%d/%d/%d), %u bytes\n", outPath.c_str(), check.getTotalCount(),
+           check.getPuzzleCount(0), check.getPuzzleCount(1), check.getPuzzleCount(2), (unsigned)catalog.size());
+    return 0;
+}
@@ -0,0 +1,156 @@
+// ==============================================================================
+// check_kernels ([env:check_kernels])
+// Cross-checks the PixelKernels implementations (Reference, Swar and the
+// host's Simd backend) on random rows of every length up to a few vectors,
+// unaligned starts included, then times each kernel on 480-pixel rows.
+//
+//   check_kernels [rounds]       (default 200 random rounds per length)
+//
+// Exits 1 on the first mismatch, printing the kernel, length and pixel.
+// ==============================================================================
+
+#include <Arduino.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include "PixelKernels.hpp"
+#include "PuzzleRandom.hpp"
+
+static const int MAX_LEN = 70;              // Several 8-lane vectors plus every tail
+static const int ROW = 480;
+
+static PuzzleRandom rng(12345);
+
+static void fill(uint16_t* p, int n) {
+    for (int i = 0; i < n; i++) p[i] = (uint16_t)rng.next();
+}
+
+static bool same(const char* kernel, const char* impl, int n, const uint16_t* want, const uint16_t* got) {
+    for (int i = 0; i < n; i++) {
+        if (want[i] != got[i]) {
+            printf("MISMATCH %s (%s) n=%d at %d: reference %04X, got %04X\n",
+                   kernel, impl, n, i, want[i], got[i]);
+            return false;
+        }
+    }
+    return true;
+}
+
+// ==============================================================================
+// Correctness: Reference vs Swar vs Simd
+// ==============================================================================
+static bool checkAll(int rounds) {
+    // +1: offset views test unaligned starts
+    uint16_t a[2 * MAX_LEN + 1], b[2 * MAX_LEN + 1];
+    uint16_t want[MAX_LEN], swar[MAX_LEN], simd[MAX_LEN];
+    uint8_t alpha[MAX_LEN + 1];
+    uint16_t map[MAX_LEN];
+
+    for (int round = 0; round < rounds; round++) {
+        for (int n = 0; n <= MAX_LEN; n++) {
+            fill(a, 2 * MAX_LEN + 1);
+            fill(b, 2 * MAX_LEN + 1);
+            for (int i = 0; i <= MAX_LEN; i++) alpha[i] = (uint8_t)rng.next();
+            alpha[0] = 0;
+            if (n > 1) alpha[n - 1] = 255;
+            uint16_t color = (uint16_t)rng.next();
+            uint8_t constAlpha = (uint8_t)(round == 0 ? 0 : round == 1 ? 255 : rng.next());
+            const uint16_t* src = a + (round & 1);
+
+            PixelKernels::Reference::swapBytes(want, src, n);
+            PixelKernels::Swar::swapBytes(swar, src, n);
+            PixelKernels::swapBytes(simd, src, n);
+            if (!same("swapBytes", "swar", n, want, swar) || !same("swapBytes", PixelKernels::backend(), n, want, simd)) return false;
+
+            PixelKernels::buildScaleMap(map, 2 * MAX_LEN, n ? n : 1);
+            PixelKernels::Reference::scaleRow(want, src, map, n);
+            PixelKernels::Swar::scaleRow(swar, src, map, n);
+            PixelKernels::scaleRow(simd, src, map, n);
+            if (!same("scaleRow", "swar", n, want, swar) || !same("scaleRow", PixelKernels::backend(), n, want, simd)) return false;
+
+            PixelKernels::Reference::downsample2x(want, src, b, n);
+            PixelKernels::Swar::downsample2x(swar, src, b, n);
+            PixelKernels::downsample2x(simd, src, b, n);
+            if (!same("downsample2x", "swar", n, want, swar) || !same("downsample2x", PixelKernels::backend(), n, want, simd)) return false;
+
+            PixelKernels::Reference::blendColor(want, src, color, constAlpha, n);
+            PixelKernels::Swar::blendColor(swar, src, color, constAlpha, n);
+            PixelKernels::blendColor(simd, src, color, constAlpha, n);
+            if (!same("blendColor", "swar", n, want, swar) || !same("blendColor", PixelKernels::backend(), n, want, simd)) return false;
+
+            PixelKernels::Reference::blendMask(want, src, alpha + (round & 1), color, n);
+            PixelKernels::Swar::blendMask(swar, src, alpha + (round & 1), color, n);
+            PixelKernels::blendMask(simd, src, alpha + (round & 1), color, n);
+            if (!same("blendMask", "swar", n, want, swar) || !same("blendMask", PixelKernels::backend(), n, want, simd)) return false;
+        }
+    }
+
+    // Fixed points of the blend: alpha 0 keeps the pixel, 255 gives the color
+    uint16_t px = 0x1234, out;
+    PixelKernels::blendColor(&out, &px, 0xF800, 0, 1);
+    if (out != px) { printf("MISMATCH blendColor alpha 0\n"); return false; }
+    PixelKernels::blendColor(&out, &px, 0xF800, 255, 1);
+    if (out != PixelKernels::swap16(0xF800)) { printf("MISMATCH blendColor alpha 255\n"); return false; }
+
+    // scaleRect (row reuse) against per-pixel division
+    std::vector<uint16_t> image(ROW * ROW), tile(130 * 130);
+    fill(image.data(), ROW * ROW);
+    uint16_t mapX[130], mapY[130];
+    PixelKernels::buildScaleMap(mapX, 160, 130);
+    PixelKernels::buildScaleMap(mapY, 160, 130);
+    PixelKernels::scaleRect(tile.data(), 130, image.data() + 160 * ROW + 320, ROW, mapX, mapY, 130, 130);
+    for (int dy = 0; dy < 130; dy++) {
+        for (int dx = 0; dx < 130; dx++) {
+            uint16_t p = image[(160 + dy * 160 / 130) * ROW + 320 + dx * 160 / 130];
+            if (tile[dy * 130 + dx] != p) {
+                printf("MISMATCH scaleRect at %d,%d\n", dx, dy);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// ==============================================================================
+// Throughput on 480-pixel rows
+// ==============================================================================
+template <typename F>
+static void timeKernel(const char* kernel, const char* impl, F f) {
+    const int iterations = 20000;
+    unsigned long t0 = micros();
+    for (int i = 0; i < iterations; i++) f();
+    unsigned long us = micros() - t0;
+    printf("  %-13s %-9s %8.1f Mpx/s\n", kernel, impl, us ? (double)iterations * ROW / us : 0.0);
+}
+
+template <typename K>
+static void timeImpl(const char* impl, uint16_t* dst, const uint16_t* a, const uint16_t* b,
+                     const uint8_t* alpha, const uint16_t* map) {
+    timeKernel("swapBytes", impl, [&] { K::swapBytes(dst, a, ROW); });
+    timeKernel("scaleRow", impl, [&] { K::scaleRow(dst, a, map, ROW); });
+    timeKernel("downsample2x", impl, [&] { K::downsample2x(dst, a, b, ROW / 2); });
+    timeKernel("blendColor", impl, [&] { K::blendColor(dst, a, 0xF800, 96, ROW); });
+    timeKernel("blendMask", impl, [&] { K::blendMask(dst, a, alpha, 0xF800, ROW); });
+}
+
+int main(int argc, char** argv) {
+    int rounds = argc > 1 ? atoi(argv[1]) : 200;
+
+    printf("=== PixelKernels cross-check (simd backend: %s) ===\n", PixelKernels::backend());
+    if (!checkAll(rounds)) return 1;
+    printf("  all kernels match the reference (%d rounds x %d lengths)\n", rounds, MAX_LEN + 1);
+
+    std::vector<uint16_t> a(ROW), b(ROW), dst(ROW), map(ROW);
+    std::vector<uint8_t> alpha(ROW);
+    fill(a.data(), ROW);
+    fill(b.data(), ROW);
+    for (int i = 0; i < ROW; i++) alpha[i] = (uint8_t)rng.next();
+    PixelKernels::buildScaleMap(map.data(), ROW, ROW);
+
+    printf("=== Throughput (480-pixel rows) ===\n");
+    timeImpl<PixelKernels::Reference>("reference", dst.data(), a.data(), b.data(), alpha.data(), map.data());
+    timeImpl<PixelKernels::Swar>("swar", dst.data(), a.data(), b.data(), alpha.data(), map.data());
+    timeImpl<PixelKernels::Simd>(PixelKernels::backend(), dst.data(), a.data(), b.data(), alpha.data(), map.data());
+    return 0;
+}
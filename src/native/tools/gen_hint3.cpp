@@ -0,0 +1,93 @@
+// ==============================================================================
+// gen_hint3 ([env:gen_hint3])
+// Breadth-first search over all 181,440 solvable 3x3 states, starting from
+// the goal. Each state records the move that steps back toward its BFS
+// parent, which is an optimal first move. Writes the packed HintTable3x3 file
+// that the firmware loads from LittleFS.
+//
+//   pio run -e gen_hint3 && .pio/build/gen_hint3/program [data/solver/hint3.bin]
+//   g++ -std=gnu++17 -O2 -Isrc src/native/tools/gen_hint3.cpp -o gen_hint3
+// ==============================================================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+#include "PuzzleBoard.hpp"
+#include "PuzzleRank.hpp"
+
+using Rank = PuzzleRank<3>;
+
+static const uint32_t STATES = (uint32_t)Rank::STATES;
+static const uint8_t UNSEEN = 0xFF;
+
+int main(int argc, char** argv) {
+    const char* outPath = argc > 1 ? argv[1] : "data/solver/hint3.bin";
+
+    // Rank/unrank must be exact inverses or every lookup is wrong
+    for (uint32_t i = 0; i < STATES; i++) {
+        PuzzleBoard<3> b = Rank::board(i);
+        if (!b.isSolvable() || Rank::index(b) != i) {
+            fprintf(stderr, "rank/unrank mismatch at %u\n", i);
+            return 1;
+        }
+    }
+
+    std::vector<uint8_t> dist(STATES, UNSEEN);
+    std::vector<uint8_t> table((STATES + 3) / 4, 0);
+    std::vector<uint32_t> queue;
+    queue.reserve(STATES);
+
+    uint32_t goal = (uint32_t)Rank::index(PuzzleBoard<3>::solved());
+    dist[goal] = 0;
+    queue.push_back(goal);
+
+    for (size_t head = 0; head < queue.size(); head++) {
+        uint32_t s = queue[head];
+        PuzzleBoard<3> board = Rank::board(s);
+
+        for (int m = 0; m < board.moveCount(); m++) {
+            MoveDir d = board.moveAt(m);
+            PuzzleBoard<3> next = board;
+            next.slide(d);
+            uint32_t j = (uint32_t)Rank::index(next);
+            if (dist[j] != UNSEEN) continue;
+
+            dist[j] = (uint8_t)(dist[s] + 1);
+            table[j >> 2] |= (uint8_t)(oppositeDir(d) << ((j & 3) * 2));
+            queue.push_back(j);
+        }
+    }
+
+    if (queue.size() != STATES) {
+        fprintf(stderr, "BFS reached %u of %u states\n", (unsigned)queue.size(), STATES);
+        return 1;
+    }
+
+    uint32_t histogram[32] = {};
+    int maxDist = 0;
+    for (uint32_t i = 0; i < STATES; i++) {
+        if (dist[i] < 32) histogram[dist[i]]++;
+        if (dist[i] > maxDist) maxDist = dist[i];
+    }
+
+    FILE* f = fopen(outPath, "wb");
+    if (!f) {
+        fprintf(stderr, "cannot write %s\n", outPath);
+        return 1;
+    }
+    uint8_t header[8] = {'H', 'N', 'T', '3',
+                         (uint8_t)STATES, (uint8_t)(STATES >> 8),
+                         (uint8_t)(STATES >> 16), (uint8_t)(STATES >> 24)};
+    bool ok = fwrite(header, 1, sizeof(header), f) == sizeof(header) &&
+              fwrite(table.data(), 1, table.size(), f) == table.size();
+    ok = (fclose(f) == 0) && ok;
+    if (!ok) {
+        fprintf(stderr, "write to %s failed\n", outPath);
+        return 1;
+    }
+
+    printf("%u states, hardest %d moves, %u bytes -> %s\n",
+           STATES, maxDist, (unsigned)(sizeof(header) + table.size()), outPath);
+    for (int d = 0; d <= maxDist; d++) printf("  %2d moves: %6u\n", d, histogram[d]);
+    return 0;
+}
@@ -0,0 +1,282 @@
+// ==============================================================================
+// gen_pdb4 ([env:gen_pdb4])
+// Builds additive pattern databases for the 4x4 board (PatternDatabase4x4).
+//
+// A pattern state is the placement of the pattern's tiles plus the blank; the
+// other tiles are indistinct. Only moves of pattern tiles cost 1, so the
+// blank roams its whole free region for free. Each state is therefore stored
+// as (placement, region), with the region named by its lowest cell, and every
+// remaining edge costs 1: a plain level-synchronous BFS. Each level's
+// frontier is split across threads; visited bits and first-reach costs are
+// claimed with atomics, so every state is expanded exactly once.
+//
+//   pio run -e gen_pdb4 && .pio/build/gen_pdb4/program [out_prefix] [tiles ...]
+//   .pio/build/gen_pdb4/program data/solver/pdb4_ 1,2,5,6,9 3,4,7,8,12 10,11,13,14,15
+//
+// Writes <out_prefix><i>.bin per pattern. The default is 5-5-5 (3 x 256 KB);
+// 6-6-3 works too (2 x 2.8 MB) but needs the PSRAM and flash space to match.
+// ==============================================================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include "PuzzleBoard.hpp"
+#include "PuzzleRank.hpp"
+
+using Rank = PuzzleRank<4>;
+
+static const int N = 4;
+static const int CELLS = 16;
+static const int MAX_TILES = 6;             // 7 tiles needs 16!/9! * 16 bits of visited state
+static const uint8_t UNSEEN = 0xFF;
+static const uint32_t CHUNK = 4096;
+
+static const uint32_t ALL_CELLS = 0xFFFF;
+static const uint32_t COL_FIRST = 0x1111;
+static const uint32_t COL_LAST = 0x8888;
+
+static uint32_t neighborMask[CELLS];
+
+// Cells of the free region containing seed (bitboard flood fill)
+static uint32_t flood(uint32_t seed, uint32_t freeCells) {
+    uint32_t region = seed;
+    while (true) {
+        uint32_t grown = region | ((region << 1) & ~COL_FIRST) | ((region >> 1) & ~COL_LAST) |
+                         (region << 4) | (region >> 4);
+        grown &= freeCells & ALL_CELLS;
+        if (grown == region) return region;
+        region = grown;
+    }
+}
+
+// Frontier entry: cell of tile i in bits 4i..4i+3, region id in bits 24..27
+static uint32_t encode(const uint8_t* cells, int k, int regionId) {
+    uint32_t s = (uint32_t)regionId << 24;
+    for (int i = 0; i < k; i++) s |= (uint32_t)cells[i] << (4 * i);
+    return s;
+}
+
+struct Pattern {
+    std::vector<uint8_t> tiles;
+};
+
+static bool parsePattern(const char* arg, Pattern& out) {
+    out.tiles.clear();
+    std::string s(arg);
+    size_t start = 0;
+    while (start <= s.size()) {
+        size_t comma = s.find(',', start);
+        if (comma == std::string::npos) comma = s.size();
+        int t = atoi(s.substr(start, comma - start).c_str());
+        if (t < 1 || t > 15) return false;
+        out.tiles.push_back((uint8_t)t);
+        start = comma + 1;
+    }
+    return !out.tiles.empty() && (int)out.tiles.size() <= MAX_TILES;
+}
+
+static bool generate(const Pattern& pattern, const std::string& path, int threads) {
+    const int k = (int)pattern.tiles.size();
+    const uint32_t size = Rank::patternSize(k);
+    auto t0 = std::chrono::steady_clock::now();
+
+    std::vector<std::atomic<uint8_t>> cost(size);
+    std::vector<std::atomic<uint16_t>> visited(size);     // One bit per region id
+    for (uint32_t i = 0; i < size; i++) {
+        cost[i].store(UNSEEN, std::memory_order_relaxed);
+        visited[i].store(0, std::memory_order_relaxed);
+    }
+
+    // Goal: tile t at cell t-1, blank in the last cell
+    uint8_t goal[MAX_TILES];
+    uint32_t occupied = 0;
+    for (int i = 0; i < k; i++) {
+        goal[i] = (uint8_t)(pattern.tiles[i] - 1);
+        occupied |= 1u << goal[i];
+    }
+    uint32_t region = flood(1u << (CELLS - 1), ~occupied);
+    int regionId = __builtin_ctz(region);
+    uint32_t goalIndex = Rank::patternIndex(goal, k);
+    cost[goalIndex] = 0;
+    visited[goalIndex] = (uint16_t)(1u << regionId);
+
+    std::vector<uint32_t> frontier(1, encode(goal, k, regionId));
+    std::vector<std::vector<uint32_t>> next(threads);
+    uint64_t states = 1;
+    int level = 0;
+
+    while (!frontier.empty()) {
+        std::atomic<uint32_t> cursor(0);
+        const uint8_t nextCost = (uint8_t)(level + 1);
+
+        auto worker = [&](std::vector<uint32_t>& out) {
+            out.clear();
+            while (true) {
+                uint32_t begin = cursor.fetch_add(CHUNK);
+                if (begin >= frontier.size()) break;
+                uint32_t end = begin + CHUNK < frontier.size() ? begin + CHUNK : (uint32_t)frontier.size();
+
+                for (uint32_t f = begin; f < end; f++) {
+                    uint32_t s = frontier[f];
+                    uint8_t cells[MAX_TILES];
+                    uint32_t occ = 0;
+                    for (int i = 0; i < k; i++) {
+                        cells[i] = (uint8_t)((s >> (4 * i)) & 0xF);
+                        occ |= 1u << cells[i];
+                    }
+                    uint32_t reach = flood(1u << (s >> 24), ~occ);
+
+                    // Slide each pattern tile into any reachable blank next to it
+                    for (int i = 0; i < k; i++) {
+                        uint8_t from = cells[i];
+                        uint32_t targets = neighborMask[from] & reach;
+                        while (targets) {
+                            int to = __builtin_ctz(targets);
+                            targets &= targets - 1;
+
+                            cells[i] = (uint8_t)to;
+                            uint32_t nocc = occ ^ (1u << from) ^ (1u << to);
+                            int id = __builtin_ctz(flood(1u << from, ~nocc));
+                            uint32_t index = Rank::patternIndex(cells, k);
+                            uint16_t bit = (uint16_t)(1u << id);
+                            if (!(visited[index].fetch_or(bit, std::memory_order_relaxed) & bit)) {
+                                out.push_back(encode(cells, k, id));
+                                uint8_t expected = UNSEEN;
+                                cost[index].compare_exchange_strong(expected, nextCost,
+                                                                    std::memory_order_relaxed);
+                            }
+                        }
+                        cells[i] = from;
+                    }
+                }
+            }
+        };
+
+        std::vector<std::thread> pool;
+        for (int t = 1; t < threads; t++) pool.emplace_back(worker, std::ref(next[t]));
+        worker(next[0]);
+        for (auto& th : pool) th.join();
+
+        frontier.clear();
+        for (auto& part : next) frontier.insert(frontier.end(), part.begin(), part.end());
+        states += frontier.size();
+        if (!frontier.empty()) level++;
+    }
+
+    // Store (cost - pattern Manhattan) / 2 in 4 bits
+    std::vector<uint8_t> packed((size + 1) / 2, 0);
+    uint64_t extraSum = 0;
+    uint32_t saturated = 0;
+    std::vector<uint8_t> cells(k, 0);
+    for (uint32_t index = 0; index < size; index++) {
+        uint8_t c = cost[index].load(std::memory_order_relaxed);
+        if (c == UNSEEN) {
+            fprintf(stderr, "placement %u never reached\n", index);
+            return false;
+        }
+        // Unrank the placement (mixed radix, as in patternIndex)
+        uint32_t rest = index;
+        uint32_t digits[MAX_TILES];
+        for (int i = k - 1; i >= 0; i--) {
+            digits[i] = rest % (uint32_t)(CELLS - i);
+            rest /= (uint32_t)(CELLS - i);
+        }
+        uint32_t unused = ALL_CELLS;
+        int md = 0;
+        for (int i = 0; i < k; i++) {
+            uint32_t m = unused;
+            for (uint32_t d = 0; d < digits[i]; d++) m &= m - 1;
+            int cell = __builtin_ctz(m);
+            unused &= ~(1u << cell);
+            md += PuzzleBoard<N>::distance(cell, pattern.tiles[i] - 1);
+        }
+
+        int extra = (c - md) / 2;
+        if (extra > 15) { extra = 15; saturated++; }
+        extraSum += extra;
+        packed[index >> 1] |= (uint8_t)(extra << ((index & 1) * 4));
+    }
+
+    FILE* f = fopen(path.c_str(), "wb");
+    if (!f) {
+        fprintf(stderr, "cannot write %s\n", path.c_str());
+        return false;
+    }
+    uint8_t header[16] = {'P', 'D', 'B', '4', (uint8_t)k};
+    for (int i = 0; i < k; i++) header[5 + i] = pattern.tiles[i];
+    header[12] = (uint8_t)size;
+    header[13] = (uint8_t)(size >> 8);
+    header[14] = (uint8_t)(size >> 16);
+    header[15] = (uint8_t)(size >> 24);
+    bool ok = fwrite(header, 1, sizeof(header), f) == sizeof(header) &&
+              fwrite(packed.data(), 1, packed.size(), f) == packed.size();
+    ok = (fclose(f) == 0) && ok;
+    if (!ok) {
+        fprintf(stderr, "write to %s failed\n", path.c_str());
+        return false;
+    }
+
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    printf("%s: %d tiles, %u placements, %llu states, depth %d, avg extra %.2f moves,"
+           " %u saturated, %.2f s\n",
+           path.c_str(), k, size, (unsigned long long)states, level,
+           2.0 * extraSum / size, saturated, secs);
+    return true;
+}
+
+int main(int argc, char** argv) {
+    std::string prefix = argc > 1 ? argv[1] : "data/solver/pdb4_";
+
+    std::vector<Pattern> patterns;
+    for (int a = 2; a < argc; a++) {
+        Pattern p;
+        if (!parsePattern(argv[a], p)) {
+            fprintf(stderr, "bad pattern '%s' (1-%d tiles from 1..15, comma separated)\n",
+                    argv[a], MAX_TILES);
+            return 1;
+        }
+        patterns.push_back(p);
+    }
+    if (patterns.empty()) {
+        patterns = {{{1, 2, 5, 6, 9}}, {{3, 4, 7, 8, 12}}, {{10, 11, 13, 14, 15}}};
+    }
+
+    // Disjoint patterns only: overlapping tiles would be counted twice
+    uint32_t seen = 0;
+    for (const Pattern& p : patterns) {
+        for (uint8_t t : p.tiles) {
+            if (seen & (1u << t)) {
+                fprintf(stderr, "tile %d is in two patterns\n", t);
+                return 1;
+            }
+            seen |= 1u << t;
+        }
+    }
+    if (patterns.size() > 4) {
+        fprintf(stderr, "at most 4 patterns\n");
+        return 1;
+    }
+
+    for (int c = 0; c < CELLS; c++) {
+        uint32_t m = 0;
+        for (int d = 0; d < 4; d++) {
+            int nb = PuzzleBoard<N>::neighbor(c, (MoveDir)d);
+            if (nb >= 0) m |= 1u << nb;
+        }
+        neighborMask[c] = m;
+    }
+
+    int threads = (int)std::thread::hardware_concurrency();
+    if (threads < 1) threads = 1;
+    printf("%d patterns, %d threads\n", (int)patterns.size(), threads);
+
+    for (size_t i = 0; i < patterns.size(); i++) {
+        if (!generate(patterns[i], prefix + std::to_string(i) + ".bin", threads)) return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,116 @@
+// ==============================================================================
+// pack_assets ([env:pack_assets])
+// Packs raw 480x480 .rgb565 puzzle images into compressed .pza assets
+// (src/PuzzleAsset.hpp) next to them, decodes each result back through
+// AssetReader to check it pixel for pixel, and reports size and decode time.
+//
+//   pack_assets [--chunk-rows n] [--remove] image.rgb565 ...
+//
+//   --chunk-rows n   rows per independently decoded band (default 16)
+//   --remove         delete each .rgb565 once its .pza checks out
+//
+// Exits 1 if any image cannot be read, written or round-tripped.
+// ==============================================================================
+
+#include <Arduino.h>
+#include <FS.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "PuzzleAsset.hpp"
+
+static const int IMAGE_SIZE = 480;
+static const size_t IMAGE_BYTES = IMAGE_SIZE * IMAGE_SIZE * 2;
+
+static bool readFile(const char* path, std::vector<uint8_t>& data) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return false;
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    data.resize(size > 0 ? size : 0);
+    bool ok = fread(data.data(), 1, data.size(), f) == data.size();
+    fclose(f);
+    return ok;
+}
+
+static bool writeFile(const char* path, const std::vector<uint8_t>& data) {
+    FILE* f = fopen(path, "wb");
+    if (!f) return false;
+    bool ok = fwrite(data.data(), 1, data.size(), f) == data.size();
+    return fclose(f) == 0 && ok;
+}
+
+int main(int argc, char** argv) {
+    int chunkRows = PuzzleAsset::DEFAULT_CHUNK_ROWS;
+    bool removeRaw = false;
+    bool usage = false;
+    std::vector<const char*> inputs;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--chunk-rows") && i + 1 < argc) chunkRows = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--remove")) removeRaw = true;
+        else if (argv[i][0] != '-') inputs.push_back(argv[i]);
+        else usage = true;
+    }
+    if (usage || inputs.empty() || chunkRows < 1 || chunkRows > IMAGE_SIZE) {
+        fprintf(stderr, "usage: %s [--chunk-rows n] [--remove] image.rgb565 ...\n", argv[0]);
+        return 2;
+    }
+
+    int failures = 0;
+    size_t rawTotal = 0, packedTotal = 0;
+    std::vector<uint8_t> raw;
+    std::vector<uint16_t> decoded(IMAGE_SIZE * IMAGE_SIZE);
+
+    for (const char* in : inputs) {
+        std::string out = in;
+        size_t dot = out.rfind('.');
+        out = (dot == std::string::npos ? out : out.substr(0, dot)) + ".pza";
+
+        if (!readFile(in, raw) || raw.size() != IMAGE_BYTES) {
+            printf("  %s: not a %d x %d RGB565 image\n", in, IMAGE_SIZE, IMAGE_SIZE);
+            failures++;
+            continue;
+        }
+        std::vector<uint16_t> pixels(IMAGE_SIZE * IMAGE_SIZE);
+        memcpy(pixels.data(), raw.data(), IMAGE_BYTES);
+
+        unsigned long t0 = micros();
+        std::vector<uint8_t> packed = PuzzleAsset::encode(pixels.data(), IMAGE_SIZE, IMAGE_SIZE, chunkRows);
+        unsigned long encodeUs = micros() - t0;
+        if (!writeFile(out.c_str(), packed)) {
+            printf("  %s: cannot write\n", out.c_str());
+            failures++;
+            continue;
+        }
+
+        // Round trip through the firmware's reader (FS shim rooted at the cwd)
+        fs::FS files(out[0] == '/' ? "" : ".");
+        AssetReader reader;
+        bool ok = reader.open(files, out.c_str()) && reader.readAll(decoded.data()) &&
+                  memcmp(decoded.data(), pixels.data(), IMAGE_BYTES) == 0;
+        const AssetReader::Stats& s = reader.getStats();
+        printf("  %-40s %7u -> %7u bytes (%5.1f%%)  encode %6.1f ms  decode %5.2f ms  %u raw band(s)  %s\n",
+               in, (unsigned)IMAGE_BYTES, (unsigned)packed.size(), 100.0 * packed.size() / IMAGE_BYTES,
+               encodeUs / 1000.0, s.decodeUs / 1000.0, (unsigned)s.rawChunks, ok ? "ok" : "MISMATCH");
+        if (!ok) {
+            failures++;
+            continue;
+        }
+        rawTotal += IMAGE_BYTES;
+        packedTotal += packed.size();
+        if (removeRaw) remove(in);
+    }
+
+    if (rawTotal) {
+        printf("Total: %u -> %u bytes (%.1f%%)\n", (unsigned)rawTotal, (unsigned)packedTotal,
+               100.0 * packedTotal / rawTotal);
+    }
+    if (failures) {
+        printf("%d failure(s)\n", failures);
+        return 1;
+    }
+    return 0;
+}
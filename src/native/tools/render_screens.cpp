@@ -0,0 +1,426 @@
+// ==============================================================================
+// render_screens ([env:render_screens])
+// Draws every game screen with src/GameScreens.hpp into a host framebuffer
+// (FrameBufferTarget), times each one, and dumps or checks the pixels:
+//
+//   render_screens [options]
+//
+//   --check            compare each screen's CRC-32 with GOLDEN_DIGESTS
+//                      below; exits 1 if any screen differs
+//   --out <dir>        write <screen>.ppm for each screen
+//   --diff <dir>       compare with <dir>/<screen>.ppm pixel for pixel and
+//                      report the changed region (PPMs from an earlier --out)
+//   --iterations <n>   renders per screen for the timing (default 50)
+//
+// Every run prints each screen's digest. After an intended visual change,
+// look at the --out snapshots and paste the new digests into GOLDEN_DIGESTS.
+//
+// Boards come from fixed shuffleUniform seeds and the tile image is a
+// synthetic pattern, so the output does not depend on ./data. Each game
+// screen is also rendered through a Compositor (back buffer + damage flush)
+// and must match the direct render exactly. Last, the blended touch flash
+// (TileOverlay) is timed on its own, and StatusBar's glyph-cell updates and
+// the scenes' partial redraws (transitions, pressed buttons, changed
+// captions) are checked against full redraws.
+// ==============================================================================
+
+#include <Arduino.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "GameScreens.hpp"
+#include "Compositor.hpp"
+#include "FrameBufferTarget.hpp"
+#include "StatusBar.hpp"
+
+static const uint32_t BOARD_SEEDS[3] = {11, 22, 33};
+
+// PuzzleAsset::crc32 of each screen's framebuffer (byte-swapped RGB565, host
+// 5x7 font), checked by --check
+struct GoldenDigest {
+    const char* name;
+    uint32_t crc32;
+};
+static const GoldenDigest GOLDEN_DIGESTS[] = {
+    {"menu", 0xcf968420},
+    {"select_medium", 0x3ebd34ff},
+    {"select_page2", 0x4db29e2c},
+    {"game_3x3", 0xbd7f68aa},
+    {"game_4x4", 0x5dedee16},
+    {"game_5x5", 0x613a14e5},
+    {"game_numbered", 0x51c61374},
+    {"game_flash", 0x38588847},
+    {"win", 0x1bf37fc0},
+    {"win_demo", 0x00150f14},
+};
+
+static const GoldenDigest* findGolden(const std::string& name) {
+    for (const GoldenDigest& g : GOLDEN_DIGESTS) {
+        if (name == g.name) return &g;
+    }
+    return nullptr;
+}
+
+// 480x480 byte-swapped RGB565 test image: diagonal gradient with a grid, so
+// scaling and tile placement errors show up as broken lines
+static std::vector<uint16_t> makeTestImage() {
+    std::vector<uint16_t> image(480 * 480);
+    for (int y = 0; y < 480; y++) {
+        for (int x = 0; x < 480; x++) {
+            uint16_t r = (uint16_t)(x * 31 / 479);
+            uint16_t g = (uint16_t)(((x + y) / 2) * 63 / 479);
+            uint16_t b = (uint16_t)(y * 31 / 479);
+            uint16_t c = (x % 40 == 0 || y % 40 == 0) ? 0xFFFF : (uint16_t)((r << 11) | (g << 5) | b);
+            image[y * 480 + x] = (uint16_t)((c << 8) | (c >> 8));
+        }
+    }
+    return image;
+}
+
+// In-memory catalog of n puzzles per difficulty, loaded like /catalog.bin
+static void makeCatalog(PuzzleManager& manager, int n) {
+    const char* names[] = {"Sunset", "Mountain Lake", "City Lights", "Forest Path", "Harbour"};
+    std::vector<PuzzleCatalog::Source> sources;
+    for (int d = 0; d < 3; d++) {
+        for (int i = 0; i < n; i++) sources.push_back({"/puzzles/test.pza", names[i % 5], d + 3, d, 0, 0, 0});
+    }
+    std::vector<uint8_t> file = PuzzleCatalog::build(sources);
+    uint8_t* buffer = (uint8_t*)malloc(file.size());
+    memcpy(buffer, file.data(), file.size());
+    manager.adopt(buffer, file.size());
+}
+
+class ScreenRenderer {
+private:
+    std::vector<uint16_t> image;
+    PuzzleManager puzzles;
+    PuzzleManager paged;        // More puzzles than the select screen's slots
+    SlidingPuzzle boards[3] = {SlidingPuzzle(3), SlidingPuzzle(4), SlidingPuzzle(5)};
+    TileAtlas atlases[3];
+    TileOverlay overlays[3];
+
+    GameView view(int d, bool withImage) {
+        GameView v = {};
+        v.puzzle = &boards[d];
+        v.atlas = withImage ? &atlases[d] : nullptr;  // Numbered: no tile pixels at all
+        v.overlay = &overlays[d];
+        v.image = withImage ? image.data() : nullptr;
+        v.layout = BoardLayout::forGrid(boards[d].getGridSize());
+        v.moves = 42;
+        v.seconds = 83;
+        v.demoActive = d == 2;
+        return v;
+    }
+
+public:
+    std::vector<std::string> names;
+    MainMenuScene menu;
+    PuzzleSelectScene select;
+    WinScene win;
+    GameScene bar;
+
+    ScreenRenderer() : image(makeTestImage()) {
+        makeCatalog(puzzles, 5);
+        makeCatalog(paged, 12);
+        for (int d = 0; d < 3; d++) {
+            boards[d].shuffleUniform(BOARD_SEEDS[d]);
+            int size = boards[d].getGridSize();
+            atlases[d].build(image.data(), size, GAME_AREA_SIZE / size, ATLAS_BOX, COL_GRID_LINE);
+            overlays[d].build(GAME_AREA_SIZE / size);
+        }
+        names = {"menu", "select_medium", "select_page2", "game_3x3", "game_4x4", "game_5x5", "game_numbered",
+                 "game_flash", "win", "win_demo"};
+    }
+
+    // Draw screen i onto gfx
+    void render(int i, RenderTarget& gfx, Blitter& painter) {
+        const std::string& name = names[i];
+        if (name == "menu") {
+            menu.drawAll(gfx, painter);
+        } else if (name == "select_medium") {
+            select.set(1, puzzles);
+            select.drawAll(gfx, painter);
+        } else if (name == "select_page2") {
+            select.set(1, paged, 1);
+            select.drawAll(gfx, painter);
+        } else if (name == "game_3x3" || name == "game_4x4" || name == "game_5x5") {
+            GameScreens::game(gfx, painter, view(name[5] - '3', true), bar);
+        } else if (name == "game_numbered") {
+            GameScreens::game(gfx, painter, view(1, false), bar);
+        } else if (name == "game_flash") {
+            GameView v = view(0, true);
+            GameScreens::game(gfx, painter, v, bar);
+            const OverlayKind kinds[3] = {OVERLAY_VALID, OVERLAY_INVALID, OVERLAY_HINT};
+            for (int k = 0; k < 3; k++) {
+                int pos = k * 3 + (boards[0].getTile(k * 3) == 0);     // Skip the empty cell
+                GameScreens::flash(gfx, painter, v, kinds[k], boards[0].getTile(pos),
+                                   v.layout.cellX(pos), v.layout.cellY(pos));
+            }
+            GameScreens::flashOutline(gfx, v.layout.cellX(2), v.layout.cellY(2), v.layout.tileSize, COL_FLASH_INVALID);
+        } else if (name == "win") {
+            win.set({image.data(), 480, 57, 125, 21, false, 0});
+            win.drawAll(gfx, painter);
+        } else if (name == "win_demo") {
+            win.set({image.data(), 480, 80, 61, -1, true, 2});
+            win.drawAll(gfx, painter);
+        }
+    }
+
+    // One blended flash (compose + blit) on a board's first tile
+    void flashOnce(int d, RenderTarget& gfx, Blitter& painter) {
+        GameView v = view(d, true);
+        int pos = boards[d].getTile(0) ? 0 : 1;
+        GameScreens::flash(gfx, painter, v, OVERLAY_INVALID, boards[d].getTile(pos),
+                           v.layout.cellX(pos), v.layout.cellY(pos));
+    }
+
+    bool isGameScreen(int i) const { return names[i].compare(0, 5, "game_") == 0; }
+
+    const PuzzleManager& getPuzzles() const { return puzzles; }
+    const PuzzleManager& getPaged() const { return paged; }
+    const uint16_t* getImage() const { return image.data(); }
+};
+
+// ==============================================================================
+// Scene partial redraws: after each step the screen must equal a full repaint
+// of the scene in its new state
+// ==============================================================================
+static int checkScene(const char* label, FrameBufferTarget& fb, Scene& scene) {
+    FrameBufferTarget full;
+    Blitter painter(full);
+    uint32_t pixels = scene.getLastPixels();
+    int rects = scene.getDrawnCount();
+    scene.drawAll(full, painter);
+    uint32_t diff = fb.countDiff(full);
+    Serial.printf("  %-26s %6u px in %2d rect(s)  %s\n", label, (unsigned)pixels, rects, diff ? "MISMATCH" : "ok");
+    return diff ? 1 : 0;
+}
+
+static int checkScenes(ScreenRenderer& r) {
+    int failures = 0;
+    FrameBufferTarget fb;
+    Blitter painter(fb);
+
+    r.menu.drawAll(fb, painter);
+    failures += checkScene("menu (full)", fb, r.menu);
+    r.menu.easy.setPressed(true);
+    r.menu.draw(fb, painter);
+    failures += checkScene("menu: press EASY", fb, r.menu);
+    r.menu.easy.setPressed(false);
+    r.menu.draw(fb, painter);
+    failures += checkScene("menu: release EASY", fb, r.menu);
+
+    r.select.set(1, r.getPuzzles());
+    r.select.show(fb, painter, &r.menu);
+    failures += checkScene("menu -> select", fb, r.select);
+    r.select.set(2, r.getPuzzles());
+    r.select.draw(fb, painter);
+    failures += checkScene("select: medium -> hard", fb, r.select);
+    r.select.set(2, r.getPaged());
+    r.select.draw(fb, painter);
+    failures += checkScene("select: 5 -> 12 puzzles", fb, r.select);
+    r.select.set(2, r.getPaged(), r.select.page() + 1);
+    r.select.draw(fb, painter);
+    failures += checkScene("select: next page", fb, r.select);
+    if (r.select.puzzleOf(r.select.hitTest(240, 95 + 10)) != 5 || r.select.hitTest(400, 440) != &r.select.more) {
+        Serial.println("  hit test select page 2: MISMATCH");
+        failures++;
+    }
+    r.select.set(2, r.getPaged(), r.select.page() + 1);
+    r.select.draw(fb, painter);
+    failures += checkScene("select: last page (2 left)", fb, r.select);
+    r.select.set(2, r.getPaged(), r.select.page() + 1);
+    r.select.draw(fb, painter);
+    failures += checkScene("select: wrap to page 1", fb, r.select);
+    PuzzleManager fewer;
+    makeCatalog(fewer, 3);
+    r.select.set(2, fewer);
+    r.select.draw(fb, painter);
+    failures += checkScene("select: 5 -> 3 puzzles", fb, r.select);
+    r.menu.show(fb, painter, &r.select);
+    failures += checkScene("select -> menu", fb, r.menu);
+
+    r.win.set({r.getImage(), 480, 57, 125, 21, false, 0});
+    r.win.show(fb, painter, &r.menu);
+    failures += checkScene("menu -> win (new bg)", fb, r.win);
+    r.win.set({r.getImage(), 480, 80, 61, -1, true, 2});
+    r.win.draw(fb, painter);
+    failures += checkScene("win: new stats", fb, r.win);
+
+    FrameBufferTarget game;                 // The bar paints only its strip
+    Blitter gamePainter(game);
+    r.bar.setDemoActive(false);
+    r.bar.drawAll(game, gamePainter);
+    r.bar.setDemoActive(true);
+    r.bar.draw(game, gamePainter);
+    failures += checkScene("game bar: Solve -> Stop", game, r.bar);
+    r.bar.hint.setPressed(true);
+    r.bar.draw(game, gamePainter);
+    failures += checkScene("game bar: press Hint", game, r.bar);
+    r.bar.hint.setPressed(false);
+    r.bar.draw(game, gamePainter);
+
+    // Hit-testing follows the drawn geometry
+    r.bar.setBoard(BoardLayout::forGrid(4));
+    struct Hit { const char* what; bool ok; } hits[] = {
+        {"menu EASY", r.menu.hitTest(100, 270) == &r.menu.easy},
+        {"menu HARD edge", r.menu.hitTest(389, 479) == &r.menu.hard},
+        {"menu title", r.menu.hitTest(240, 100) == nullptr},
+        {"select puzzle 3", r.select.puzzleOf(r.select.hitTest(240, 95 + 2 * 65 + 10)) == 2},
+        {"select hidden 5", r.select.hitTest(240, 95 + 4 * 65 + 10) == nullptr},
+        {"select back", r.select.hitTest(20, 440) == &r.select.back},
+        {"select no more", r.select.hitTest(400, 440) == nullptr},
+        {"win again", r.win.hitTest(60, 410) == &r.win.again},
+        {"bar solve", r.bar.hitTest(250, 440) == &r.bar.solve},
+        {"bar gap", r.bar.hitTest(120, 440) == nullptr},
+        {"board cell", r.bar.board.cellAt(r.bar.board.bounds().x + 97 * 2 + 5, r.bar.board.bounds().y + 97 + 5) == 6},
+    };
+    for (const Hit& h : hits) {
+        if (h.ok) continue;
+        Serial.printf("  hit test %s: MISMATCH\n", h.what);
+        failures++;
+    }
+    return failures;
+}
+
+int main(int argc, char** argv) {
+    const char* outDir = nullptr;
+    const char* diffDir = nullptr;
+    bool check = false;
+    int iterations = 50;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--check")) check = true;
+        else if (!strcmp(argv[i], "--out") && i + 1 < argc) outDir = argv[++i];
+        else if (!strcmp(argv[i], "--diff") && i + 1 < argc) diffDir = argv[++i];
+        else if (!strcmp(argv[i], "--iterations") && i + 1 < argc) iterations = max(1, atoi(argv[++i]));
+        else {
+            fprintf(stderr, "usage: %s [--check] [--out dir] [--diff dir] [--iterations n]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    ScreenRenderer renderer;
+    int failures = 0;
+
+    Serial.println("=== Screen renders (480x480 host framebuffer) ===");
+    for (int i = 0; i < (int)renderer.names.size(); i++) {
+        const std::string& name = renderer.names[i];
+        FrameBufferTarget fb;
+        Blitter painter(fb);
+
+        unsigned long t0 = micros();
+        for (int n = 0; n < iterations; n++) {
+            Blitter::Frame frame(painter);
+            renderer.render(i, fb, painter);
+        }
+        unsigned long us = micros() - t0;
+        // Game screens through the compositor must land on the panel unchanged
+        const char* composited = "";
+        if (renderer.isGameScreen(i)) {
+            FrameBufferTarget panel, canvas;
+            Blitter out(panel);
+            Compositor compositor(panel, out);
+            compositor.begin(canvas);
+            compositor.damageAll();
+            renderer.render(i, compositor.gfx(), compositor.painter());
+            compositor.flush();
+            composited = "  composited ok";
+            if (panel.countDiff(fb)) {
+                composited = "  composited MISMATCH";
+                failures++;
+            }
+        }
+
+        const Blitter::Counters& c = painter.getLastFrame();
+        Serial.printf("  %-14s %8.1f us/render  (%u blits, %u px)%s", name.c_str(),
+                      (double)us / iterations, (unsigned)c.calls, (unsigned)c.pixels, composited);
+
+        uint32_t crc = PuzzleAsset::crc32((const uint8_t*)fb.buffer(),
+                                          (size_t)fb.width() * fb.height() * sizeof(uint16_t));
+        Serial.printf("  crc %08x", (unsigned)crc);
+        if (check) {
+            const GoldenDigest* golden = findGolden(name);
+            if (!golden) {
+                Serial.print("  NO GOLDEN");
+                failures++;
+            } else if (golden->crc32 != crc) {
+                Serial.printf("  DIFFERS from golden %08x", (unsigned)golden->crc32);
+                failures++;
+            } else {
+                Serial.print("  matches golden");
+            }
+        }
+
+        std::string file = name + ".ppm";
+        if (outDir) {
+            std::string path = std::string(outDir) + "/" + file;
+            if (!fb.writePPM(path.c_str())) {
+                Serial.printf("  cannot write %s", path.c_str());
+                failures++;
+            }
+        }
+        if (diffDir) {
+            std::string path = std::string(diffDir) + "/" + file;
+            FrameBufferTarget before;
+            if (!before.readPPM(path.c_str())) {
+                Serial.printf("  no snapshot %s", path.c_str());
+                failures++;
+            } else {
+                int x0 = 0, y0 = 0, x1 = 0, y1 = 0;
+                uint32_t diff = fb.countDiff(before, &x0, &y0, &x1, &y1);
+                if (diff) {
+                    Serial.printf("  DIFFERS: %u px in (%d,%d)-(%d,%d)", (unsigned)diff, x0, y0, x1, y1);
+                    failures++;
+                } else {
+                    Serial.print("  matches snapshot");
+                }
+            }
+        }
+        Serial.println();
+    }
+
+    // Glyph-cell status bar updates must equal a full redraw of the new state
+    Serial.println("=== Status bar glyph updates (vs full redraw) ===");
+    {
+        FrameBufferTarget scratch(480, 8 * STATUS_TEXT_SIZE);
+        StatusBar bar;
+        bar.begin(scratch);
+        const int steps[][4] = {{42, 83, 42, 84}, {42, 83, 43, 83}, {9, 59, 10, 60},
+                                {99, 599, 100, 600}, {999, 5999, 1000, 6000}, {1234, 0, 7, 61}};
+        for (const auto& st : steps) {
+            FrameBufferTarget incremental, full;
+            Blitter painter(incremental);
+            GameScreens::statusBar(incremental, st[0], st[1]);
+            bar.shown(st[0], st[1]);
+            bool ok = bar.update(painter, st[2], st[3]);
+            GameScreens::statusBar(full, st[2], st[3]);
+            uint32_t diff = incremental.countDiff(full);
+            Serial.printf("  %4d %5d -> %4d %5d: %5u px in %d rect(s)  %s\n", st[0], st[1], st[2], st[3],
+                          (unsigned)bar.getLastPixels(), bar.getDirtyCount(),
+                          ok && !diff ? "ok" : "MISMATCH");
+            if (!ok || diff) failures++;
+        }
+    }
+
+    Serial.println("=== Scene redraws (vs full repaint) ===");
+    failures += checkScenes(renderer);
+
+    Serial.println("=== Blended flash (compose + blit, one tile) ===");
+    for (int d = 0; d < 3; d++) {
+        FrameBufferTarget fb;
+        Blitter painter(fb);
+        unsigned long t0 = micros();
+        for (int n = 0; n < iterations * 20; n++) renderer.flashOnce(d, fb, painter);
+        unsigned long us = micros() - t0;
+        int size = GAME_AREA_SIZE / (d + 3);
+        Serial.printf("  %dx%d  %3d px tile: %6.1f us/flash\n", d + 3, d + 3, size, (double)us / (iterations * 20));
+    }
+
+    if (failures) {
+        Serial.printf("%d failure(s)\n", failures);
+        return 1;
+    }
+    return 0;
+}